@@ -1,22 +1,47 @@
 #include "AI.h"
+#include "ThreatSearch.h"
+#include "LatencyHistogram.h"
 #include <random>
 #include <algorithm>
 #include <climits>
 #include <vector>
 
-AI::AI(AILevel level) : difficulty(level) {}
+AI::AI(AILevel level) : difficulty(level), useOpeningBook(true), searchDepth(0), timeLimitMs(0),
+                        rng(std::random_device()()), useDeadline(false), searchAborted(false), nodesSearched(0), stopFlag(nullptr),
+                        latencyTable(nullptr) {}
 
 std::pair<int, int> AI::getMove(const Board& board, CellState aiPlayer) {
+    auto start = std::chrono::steady_clock::now();
+    lastStats = SearchStats();
+    nodesSearched = 0;
+    
+    std::pair<int, int> move;
     switch (difficulty) {
         case EASY:
-            return getRandomMove(board);
+            move = getRandomMove(board);
+            break;
         case MEDIUM:
-            return getMediumMove(board, aiPlayer);
+            move = getMediumMove(board, aiPlayer);
+            break;
         case HARD:
-            return getHardMove(board, aiPlayer);
+            move = getHardMove(board, aiPlayer);
+            break;
+        case NEURAL:
+            move = getNeuralMove(board, aiPlayer);
+            break;
         default:
-            return getRandomMove(board);
+            move = getRandomMove(board);
+            break;
+    }
+    
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    lastStats.nodes += nodesSearched;
+    lastStats.elapsedMs = std::chrono::duration<double, std::milli>(elapsed).count();
+    if (latencyTable) {
+        latencyTable->record(difficulty, board.getSize(),
+                             (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
     }
+    return move;
 }
 
 void AI::setLevel(AILevel level) {
@@ -27,17 +52,63 @@ AILevel AI::getLevel() const {
     return difficulty;
 }
 
+void AI::saveCache() {
+    cache.flush();
+}
+
+void AI::setPersistentCache(bool enabled) {
+    cache.setPersistent(enabled);
+}
+
+size_t AI::getCacheEntryCount() const {
+    return cache.getEntryCount();
+}
+
+void AI::clearCache() {
+    cache.clear();
+}
+
+void AI::setOpeningBookEnabled(bool enabled) {
+    useOpeningBook = enabled;
+}
+
+void AI::setSearchDepth(int depth) {
+    searchDepth = depth;
+}
+
+void AI::setTimeLimit(int milliseconds) {
+    timeLimitMs = milliseconds;
+}
+
+void AI::setSeed(unsigned int seed) {
+    rng.seed(seed);
+}
+
+void AI::setStopFlag(const std::atomic<bool>* flag) {
+    stopFlag = flag;
+}
+
+void AI::setProgressCallback(SearchProgressCallback callback) {
+    progressCallback = callback;
+}
+
+void AI::setLatencyTable(MoveLatencyTable* table) {
+    latencyTable = table;
+}
+
+SearchStats AI::getLastSearchStats() const {
+    return lastStats;
+}
+
 std::pair<int, int> AI::getRandomMove(const Board& board) {
     auto emptyCells = board.getEmptyCells();
     if (emptyCells.empty()) {
         return {-1, -1}; // No valid moves
     }
     
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
     std::uniform_int_distribution<> dis(0, emptyCells.size() - 1);
     
-    return emptyCells[dis(gen)];
+    return emptyCells[dis(rng)];
 }
 
 std::pair<int, int> AI::getMediumMove(const Board& board, CellState aiPlayer) {
@@ -82,40 +153,181 @@ std::pair<int, int> AI::getHardMove(const Board& board, CellState aiPlayer) {
         return {-1, -1};
     }
     
-    // Limit search depth based on board size to prevent crashes
-    int boardSize = board.getSize();
-    int maxDepth;
-    if (boardSize <= 3) {
-        maxDepth = 9; // Full search for 3x3
-    } else if (boardSize == 4) {
-        maxDepth = 6; // Limited depth for 4x4
-    } else if (boardSize == 5) {
-        maxDepth = 4; // More limited for 5x5
-    } else {
-        maxDepth = 3; // Very limited for 6x6
+    // Openings are answered from the book without searching
+    if (useOpeningBook && openingBook.open(board.getSize(), board.getWinCondition())) {
+        auto bookMove = openingBook.getMove(board, aiPlayer, rng);
+        if (bookMove.first != -1) {
+            return bookMove;
+        }
     }
     
+    // On larger win conditions look for a forced win through continuous
+    // threats first; it sees much deeper than the depth-limited minimax
+    if (board.getWinCondition() >= THREAT_SEARCH_MIN_WIN_CONDITION) {
+        int threatTime = THREAT_SEARCH_TIME_MS;
+        if (timeLimitMs > 0) {
+            threatTime = std::min(threatTime, std::max(timeLimitMs / 4, 1));
+        }
+        
+        ThreatSearch threatSearch;
+        auto forcedWin = threatSearch.findForcedWin(board, aiPlayer, threatTime);
+        lastStats.nodes += threatSearch.getNodesSearched();
+        if (forcedWin.first != -1) {
+            lastStats.score = 9; // Proven win; the threat search does not count plies
+            return forcedWin;
+        }
+    }
+    
+    // Score all moves and keep the first best one
+    std::vector<MoveAnalysis> analysis = analyze(board, aiPlayer);
+    
     int bestScore = INT_MIN;
     std::pair<int, int> bestMove = {-1, -1};
     
-    CellState humanPlayer = getOpponent(aiPlayer);
+    for (const auto& move : analysis) {
+        if (move.score > bestScore) {
+            bestScore = move.score;
+            bestMove = {move.row, move.col};
+        }
+    }
+    
+    lastStats.score = bestScore;
+    return bestMove;
+}
+
+std::pair<int, int> AI::getNeuralMove(const Board& board, CellState aiPlayer) {
+    // Without trained weights for this board, play like Medium
+    if (!neuralNet.load(board.getSize(), board.getWinCondition())) {
+        return getMediumMove(board, aiPlayer);
+    }
+    
+    // Never miss an immediate win or block; the network decides the rest
+    auto winMove = findWinningMove(board, aiPlayer);
+    if (winMove.first != -1) {
+        return winMove;
+    }
     
+    auto blockMove = findBlockingMove(board, getOpponent(aiPlayer));
+    if (blockMove.first != -1) {
+        return blockMove;
+    }
+    
+    return neuralNet.getBestMove(board, aiPlayer);
+}
+
+std::vector<MoveAnalysis> AI::analyze(const Board& board, CellState player) {
+    std::vector<MoveAnalysis> analysis;
+    auto emptyCells = board.getEmptyCells();
+    if (emptyCells.empty() || board.checkWin().hasWinner) {
+        return analysis;
+    }
+    
+    cache.configure(board.getSize(), board.getWinCondition());
+    searchAborted = false;
+    useDeadline = false;
+    
+    // A fixed-depth search runs once, unless it must report progress or be
+    // stoppable from outside, which both need completed iterations
+    if (timeLimitMs <= 0 && !stopFlag && !progressCallback) {
+        lastStats.depth = getSearchDepth(board.getSize());
+        return searchRoot(board, player, lastStats.depth);
+    }
+    
+    // Iterative deepening: keep the deepest iteration that finished in time.
+    // The first iteration always completes so there is always a result.
+    auto start = std::chrono::steady_clock::now();
+    int maxDepth = getSearchDepth(board.getSize());
+    if (timeLimitMs > 0) {
+        deadline = start + std::chrono::milliseconds(timeLimitMs);
+        maxDepth = (searchDepth > 0) ? searchDepth : (int)emptyCells.size();
+    } else {
+        deadline = std::chrono::steady_clock::time_point::max();
+    }
+    
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        std::vector<MoveAnalysis> result = searchRoot(board, player, depth);
+        if (searchAborted) break;
+        
+        analysis = result;
+        lastStats.depth = depth;
+        useDeadline = true;
+        
+        // Depth cut-offs score as draws, so a win (or every move losing)
+        // is already proven and deeper iterations cannot change it
+        const MoveAnalysis* best = &analysis[0];
+        for (const auto& move : analysis) {
+            if (move.score > best->score) best = &move;
+        }
+        
+        if (progressCallback) {
+            SearchStats progress = lastStats;
+            progress.nodes += nodesSearched;
+            progress.score = best->score;
+            progress.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            progressCallback(progress, *best);
+        }
+        
+        if (std::chrono::steady_clock::now() >= deadline || (stopFlag && *stopFlag)) break;
+        if (best->score != 0) break;
+    }
+    
+    useDeadline = false;
+    return analysis;
+}
+
+std::vector<MoveAnalysis> AI::searchRoot(const Board& board, CellState player, int maxDepth) {
+    std::vector<MoveAnalysis> analysis;
+    CellState opponent = getOpponent(player);
+    auto emptyCells = board.getEmptyCells();
+    
+    // Every root move gets an exact score, so one pass over the root
+    // yields the full ranking instead of running a search per cell
     for (const auto& cell : emptyCells) {
         Board tempBoard = board;
-        tempBoard.makeMove(cell.first, cell.second, aiPlayer);
+        tempBoard.makeMove(cell.first, cell.second, player);
         
-        int score = minimax(tempBoard, 0, false, aiPlayer, humanPlayer, maxDepth);
+        MoveAnalysis move;
+        move.row = cell.first;
+        move.col = cell.second;
+        move.principalVariation.push_back(cell);
         
-        if (score > bestScore) {
-            bestScore = score;
-            bestMove = cell;
-        }
+        std::vector<std::pair<int, int>> reply;
+        move.score = minimax(tempBoard, 0, false, player, opponent, maxDepth, &reply);
+        move.principalVariation.insert(move.principalVariation.end(), reply.begin(), reply.end());
+        
+        if (searchAborted) break;
+        analysis.push_back(move);
     }
     
-    return bestMove;
+    return analysis;
+}
+
+int AI::getSearchDepth(int boardSize) const {
+    if (searchDepth > 0) {
+        return searchDepth;
+    }
+    return getDefaultSearchDepth(boardSize);
 }
 
-int AI::minimax(Board board, int depth, bool isMaximizing, CellState aiPlayer, CellState humanPlayer, int maxDepth) {
+int AI::getDefaultSearchDepth(int boardSize) {
+    // Limit search depth based on board size to prevent crashes
+    if (boardSize <= 3) {
+        return 9; // Full search for 3x3
+    } else if (boardSize == 4) {
+        return 6; // Limited depth for 4x4
+    } else if (boardSize == 5) {
+        return 4; // More limited for 5x5
+    }
+    return 3; // Very limited for 6x6
+}
+
+int AI::minimax(Board board, int depth, bool isMaximizing, CellState aiPlayer, CellState humanPlayer, int maxDepth,
+                std::vector<std::pair<int, int>>* pv) {
+    nodesSearched++;
+    if (isTimeUp()) {
+        return 0; // Result is discarded by the caller
+    }
+    
     WinInfo winInfo = board.checkWin();
     
     // Terminal states
@@ -131,30 +343,91 @@ int AI::minimax(Board board, int depth, bool isMaximizing, CellState aiPlayer, C
         return 0; // Draw or depth limit reached
     }
     
-    if (isMaximizing) {
-        int maxScore = INT_MIN;
-        auto emptyCells = board.getEmptyCells();
+    int boardSize = board.getSize();
+    int remainingDepth = maxDepth - depth;
+    CellState mover = isMaximizing ? aiPlayer : humanPlayer;
+    
+    // Cached scores are stored from the mover's side and relative to the
+    // cached position, so they are valid at any ply and for either player
+    uint64_t key = PositionCache::makeKey(board, mover);
+    int cachedScore, cachedMove;
+    if (cache.lookup(key, remainingDepth, cachedScore, cachedMove)) {
+        if (cachedScore > 0) cachedScore -= depth;
+        if (cachedScore < 0) cachedScore += depth;
         
-        for (const auto& cell : emptyCells) {
-            Board tempBoard = board;
-            tempBoard.makeMove(cell.first, cell.second, aiPlayer);
-            int score = minimax(tempBoard, depth + 1, false, aiPlayer, humanPlayer, maxDepth);
-            maxScore = std::max(maxScore, score);
+        if (pv && cachedMove >= 0) {
+            pv->clear();
+            extendPvFromCache(board, mover, cachedMove, remainingDepth, *pv);
         }
+        return isMaximizing ? cachedScore : -cachedScore;
+    }
+    
+    int bestScore = isMaximizing ? INT_MIN : INT_MAX;
+    int bestCell = -1;
+    std::vector<std::pair<int, int>> childPv;
+    auto emptyCells = board.getEmptyCells();
+    
+    for (const auto& cell : emptyCells) {
+        Board tempBoard = board;
+        tempBoard.makeMove(cell.first, cell.second, mover);
         
-        return maxScore;
-    } else {
-        int minScore = INT_MAX;
-        auto emptyCells = board.getEmptyCells();
+        childPv.clear();
+        int score = minimax(tempBoard, depth + 1, !isMaximizing, aiPlayer, humanPlayer, maxDepth,
+                            pv ? &childPv : nullptr);
         
-        for (const auto& cell : emptyCells) {
-            Board tempBoard = board;
-            tempBoard.makeMove(cell.first, cell.second, humanPlayer);
-            int score = minimax(tempBoard, depth + 1, true, aiPlayer, humanPlayer, maxDepth);
-            minScore = std::min(minScore, score);
+        bool better = isMaximizing ? (score > bestScore) : (score < bestScore);
+        if (better) {
+            bestScore = score;
+            bestCell = cell.first * boardSize + cell.second;
+            
+            // Track the line that produced the best score
+            if (pv) {
+                pv->clear();
+                pv->push_back(cell);
+                pv->insert(pv->end(), childPv.begin(), childPv.end());
+            }
         }
+    }
+    
+    // Never cache a partial result
+    if (searchAborted) {
+        return 0;
+    }
+    
+    int storedScore = isMaximizing ? bestScore : -bestScore;
+    if (storedScore > 0) storedScore += depth;
+    if (storedScore < 0) storedScore -= depth;
+    cache.store(key, remainingDepth, storedScore, bestCell);
+    
+    return bestScore;
+}
+
+bool AI::isTimeUp() {
+    // Only poll the clock and stop flag every thousand nodes or so
+    if (useDeadline && !searchAborted && (nodesSearched & 1023) == 0 &&
+        ((stopFlag && *stopFlag) || std::chrono::steady_clock::now() >= deadline)) {
+        searchAborted = true;
+    }
+    return searchAborted;
+}
+
+void AI::extendPvFromCache(Board board, CellState mover, int firstMove, int maxLength,
+                           std::vector<std::pair<int, int>>& pv) {
+    // Follow the cached best moves to rebuild the rest of the line
+    int boardSize = board.getSize();
+    int move = firstMove;
+    
+    while (move >= 0 && (int)pv.size() < maxLength) {
+        int row = move / boardSize;
+        int col = move % boardSize;
+        if (!board.makeMove(row, col, mover)) break;
+        pv.push_back({row, col});
+        
+        if (board.checkWin().hasWinner || board.isFull()) break;
         
-        return minScore;
+        mover = getOpponent(mover);
+        int score;
+        if (!cache.lookup(PositionCache::makeKey(board, mover), 0, score, move)) break;
     }
 }
 
@@ -2,15 +2,48 @@
 #define AI_H
 
 #include "Board.h"
+#include "PositionCache.h"
+#include "OpeningBook.h"
+#include "NeuralNet.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <random>
 #include <utility>
 #include <vector>
 
+class MoveLatencyTable;
+
 enum AILevel {
     EASY = 0,
     MEDIUM = 1,
-    HARD = 2
+    HARD = 2,
+    NEURAL = 3
+};
+
+// Search result for a single candidate move
+struct MoveAnalysis {
+    int row, col;
+    int score;  // From the analysing player's point of view (win: +10, loss: -10, draw: 0)
+    std::vector<std::pair<int, int>> principalVariation; // Expected line, starting with this move
+    
+    MoveAnalysis() : row(-1), col(-1), score(0) {}
 };
 
+// Statistics of the most recent getMove/analyze call
+struct SearchStats {
+    unsigned long long nodes;   // Minimax and threat search nodes
+    int depth;                  // Deepest completed minimax depth (0 = no search)
+    int score;                  // Score of the chosen move (Hard)
+    double elapsedMs;
+    
+    SearchStats() : nodes(0), depth(0), score(0), elapsedMs(0.0) {}
+};
+
+// Called after each completed iteration of an iterative-deepening search
+// with the statistics so far and the best move of that iteration
+typedef std::function<void(const SearchStats&, const MoveAnalysis&)> SearchProgressCallback;
+
 class AI {
 public:
     AI(AILevel level = MEDIUM);
@@ -18,25 +51,87 @@ public:
     // Get the AI's move for the given board state
     std::pair<int, int> getMove(const Board& board, CellState aiPlayer);
     
+    // Score every empty cell for the given player with one shared search
+    std::vector<MoveAnalysis> analyze(const Board& board, CellState player);
+    
     // Set AI difficulty level
     void setLevel(AILevel level);
     AILevel getLevel() const;
     
+    // Write new search results to the on-disk position cache (call at game end)
+    void saveCache();
+    void setPersistentCache(bool enabled);
+    
+    // In-memory search results; long-running callers clear them to bound memory
+    size_t getCacheEntryCount() const;
+    void clearCache();
+    
+    // Consult book_<N>x<N>_<win>.bin before searching in Hard mode
+    void setOpeningBookEnabled(bool enabled);
+    
+    // Override the Hard search depth (0 = depth table by board size)
+    void setSearchDepth(int depth);
+    // The depth table: Hard's search depth for a board size without an override
+    static int getDefaultSearchDepth(int boardSize);
+    
+    // Per-move time budget for Hard mode (0 = fixed depth, no limit).
+    // With a budget the search deepens iteratively until time runs out.
+    void setTimeLimit(int milliseconds);
+    
+    // Seed the random choices (Easy moves, book moves) for reproducible games
+    void setSeed(unsigned int seed);
+    
+    SearchStats getLastSearchStats() const;
+    
+    // Abort the Hard search as soon as *flag becomes true (nullptr = none).
+    // The best move of the deepest completed iteration is returned.
+    void setStopFlag(const std::atomic<bool>* flag);
+    void setProgressCallback(SearchProgressCallback callback);
+    
+    // Record the time of every getMove call under (level, board size) (nullptr = none)
+    void setLatencyTable(MoveLatencyTable* table);
+    
+    // Find a cell that wins immediately for player, or {-1, -1}
+    std::pair<int, int> findWinningMove(const Board& board, CellState player);
+    
 private:
     AILevel difficulty;
+    PositionCache cache;
+    OpeningBook openingBook;
+    NeuralNet neuralNet;
+    bool useOpeningBook;
+    int searchDepth;
+    int timeLimitMs;
+    std::mt19937 rng;
+    
+    // Search control
+    bool useDeadline;
+    bool searchAborted;
+    unsigned long long nodesSearched;
+    std::chrono::steady_clock::time_point deadline;
+    SearchStats lastStats;
+    const std::atomic<bool>* stopFlag;
+    SearchProgressCallback progressCallback;
+    MoveLatencyTable* latencyTable;
     
     // Different AI strategies
     std::pair<int, int> getRandomMove(const Board& board);
     std::pair<int, int> getMediumMove(const Board& board, CellState aiPlayer);
     std::pair<int, int> getHardMove(const Board& board, CellState aiPlayer);
+    std::pair<int, int> getNeuralMove(const Board& board, CellState aiPlayer);
     
     // Minimax algorithm for hard difficulty
-    int minimax(Board board, int depth, bool isMaximizing, CellState aiPlayer, CellState humanPlayer, int maxDepth);
+    int minimax(Board board, int depth, bool isMaximizing, CellState aiPlayer, CellState humanPlayer, int maxDepth,
+                std::vector<std::pair<int, int>>* pv);
+    std::vector<MoveAnalysis> searchRoot(const Board& board, CellState player, int maxDepth);
+    int getSearchDepth(int boardSize) const;
+    bool isTimeUp();
+    void extendPvFromCache(Board board, CellState mover, int firstMove, int maxLength,
+                           std::vector<std::pair<int, int>>& pv);
     
     // Helper functions
     CellState getOpponent(CellState player);
     int evaluateBoard(const Board& board, CellState aiPlayer, CellState humanPlayer);
-    std::pair<int, int> findWinningMove(const Board& board, CellState player);
     std::pair<int, int> findBlockingMove(const Board& board, CellState player);
 };
 
@@ -1,5 +1,15 @@
 #include "Board.h"
 
+namespace {
+    // Fixed-seed Zobrist keys (splitmix64) so hashes can be saved to disk
+    uint64_t zobristKey(int cellIndex, CellState player) {
+        uint64_t z = (uint64_t)(cellIndex * 2 + player) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+}
+
 Board::Board(int size, int winCond) : boardSize(size), winCondition(winCond) {
     resize(size, winCond);
 }
@@ -30,6 +40,11 @@ bool Board::makeMove(int row, int col, CellState player) {
     return true;
 }
 
+void Board::undoMove(int row, int col) {
+    if (row < 0 || row >= boardSize || col < 0 || col >= boardSize) return;
+    grid[row][col] = EMPTY;
+}
+
 CellState Board::getCell(int row, int col) const {
     if (row < 0 || row >= boardSize || col < 0 || col >= boardSize) return EMPTY;
     return grid[row][col];
@@ -43,6 +58,18 @@ int Board::getWinCondition() const {
     return winCondition;
 }
 
+uint64_t Board::getHash() const {
+    uint64_t hash = 0;
+    for (int i = 0; i < boardSize; i++) {
+        for (int j = 0; j < boardSize; j++) {
+            if (grid[i][j] != EMPTY) {
+                hash ^= zobristKey(i * boardSize + j, grid[i][j]);
+            }
+        }
+    }
+    return hash;
+}
+
 bool Board::checkLine(int startRow, int startCol, int deltaRow, int deltaCol, WinInfo& winInfo) const {
     CellState firstCell = grid[startRow][startCol];
     if (firstCell == EMPTY) return false;
@@ -124,3 +151,13 @@ std::vector<std::pair<int, int>> Board::getEmptyCells() const {
     }
     return emptyCells;
 }
+
+int getDefaultWinCondition(int boardSize) {
+    switch (boardSize) {
+        case 3: return WIN_CONDITION_3X3;
+        case 4: return WIN_CONDITION_4X4;
+        case 5: return WIN_CONDITION_5X5;
+        case 6: return WIN_CONDITION_6X6;
+        default: return WIN_CONDITION_3X3;
+    }
+}
@@ -3,6 +3,13 @@
 
 #include <vector>
 #include <utility>
+#include <cstdint>
+
+// Win condition rules (minimum alignment needed to win for each board size)
+const int WIN_CONDITION_3X3 = 3;  // 3 in a row for 3x3
+const int WIN_CONDITION_4X4 = 4;  // 4 in a row for 4x4
+const int WIN_CONDITION_5X5 = 4;  // 4 in a row for 5x5 (not 5 to keep it playable)
+const int WIN_CONDITION_6X6 = 5;  // 5 in a row for 6x6
 
 enum CellState {
     EMPTY = 0,
@@ -24,6 +31,7 @@ public:
     void reset();
     void resize(int newSize, int newWinCondition);
     bool makeMove(int row, int col, CellState player);
+    void undoMove(int row, int col);
     CellState getCell(int row, int col) const;
     WinInfo checkWin() const;
     bool isFull() const;
@@ -31,6 +39,9 @@ public:
     int getSize() const;
     int getWinCondition() const;
     
+    // Zobrist hash of the cell contents; stable across runs
+    uint64_t getHash() const;
+    
 private:
     std::vector<std::vector<CellState>> grid;
     int boardSize;
@@ -39,4 +50,7 @@ private:
     bool checkLine(int startRow, int startCol, int deltaRow, int deltaCol, WinInfo& winInfo) const;
 };
 
+// Win condition for a board size under the rules above
+int getDefaultWinCondition(int boardSize);
+
 #endif
@@ -0,0 +1,82 @@
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+// Blocking multi-producer/multi-consumer FIFO with a fixed capacity.
+// push() waits while the queue is full, so a fast producer is throttled to
+// the speed of its consumers and memory use stays constant; tryPush() is for
+// producers that must never block. close() wakes everyone: pushes fail from
+// then on and pops drain what is left.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1), closed(false) {}
+
+    // Returns false if the queue was closed before the item could be added
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return closed || items.size() < capacity; });
+        if (closed) return false;
+
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Returns false at once if the queue is full or closed
+    bool tryPush(T item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closed || items.size() >= capacity) return false;
+
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Returns false once the queue is closed and empty
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return closed || !items.empty(); });
+        if (items.empty()) return false;
+
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    // Drops everything queued, e.g. work nobody waits for anymore
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        items.clear();
+        notFull.notify_all();
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+private:
+    BoundedQueue(const BoundedQueue&);
+    BoundedQueue& operator=(const BoundedQueue&);
+
+    const size_t capacity;
+    bool closed;
+    std::deque<T> items;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+};
+
+#endif
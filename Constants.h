@@ -10,18 +10,14 @@ const int INITIAL_WINDOW_WIDTH = 800;
 const int INITIAL_WINDOW_HEIGHT = 600;
 const int TARGET_FPS = 60;
 const int FRAME_DELAY = 1000 / TARGET_FPS;
+const int IDLE_WAIT_TIMEOUT = 1000;  // Longest sleep while nothing moves, milliseconds
+const int AI_MOVE_DELAY = 500;       // Pause before the AI moves, milliseconds
 
 // Board size options
 const int MIN_BOARD_SIZE = 3;
 const int MAX_BOARD_SIZE = 6;
 const int DEFAULT_BOARD_SIZE = 3;
 
-// Win condition rules (minimum alignment needed to win for each board size)
-const int WIN_CONDITION_3X3 = 3;  // 3 in a row for 3x3
-const int WIN_CONDITION_4X4 = 4;  // 4 in a row for 4x4
-const int WIN_CONDITION_5X5 = 4;  // 4 in a row for 5x5 (not 5 to keep it playable)
-const int WIN_CONDITION_6X6 = 5;  // 5 in a row for 6x6
-
 // Colors (RGB format)
 const SDL_Color COLOR_BG_PRIMARY = {26, 26, 46, 255};      // #1a1a2e
 const SDL_Color COLOR_BG_SECONDARY = {22, 33, 62, 255};    // #16213e
@@ -57,6 +53,21 @@ const int AUDIO_CHUNK_SIZE = 2048;
 // Animation settings (additional)
 const float WIN_LINE_ANIMATION_DURATION = 1000.0f; // milliseconds
 const float MENU_TRANSITION_DURATION = 300.0f;     // milliseconds
+const int ANIMATION_POOL_SIZE = 64;                // Animations running at once; the oldest is recycled past this
+const float ANIMATION_MAX_STEP = 50.0f;            // Longest frame step fed to animations, milliseconds
 const float PIECE_BOUNCE_HEIGHT = 0.2f;            // Scale factor for bounce effect
 
+// Move hint settings (toggled with H)
+const int HINT_TIME_LIMIT = 50;                    // Milliseconds of search per position; deeper iterations are cut off
+
+// Profiler overlay settings (toggled with P)
+const int PROFILER_BAR_WIDTH = 2;                  // Pixels per frame in the graph
+const int PROFILER_GRAPH_HEIGHT = 64;              // Pixels
+const float PROFILER_GRAPH_RANGE = 33333.0f;       // Microseconds the graph height stands for: two 60 FPS frames
+
+// Render benchmark settings (--render-bench)
+const int RENDER_BENCH_DEFAULT_FRAMES = 600;  // Frames per scene
+const int RENDER_BENCH_MOVE_INTERVAL = 20;    // Frames between scripted moves
+const int RENDER_BENCH_HOVER_INTERVAL = 30;   // Frames between pointer moves on menus
+
 #endif
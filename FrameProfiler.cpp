@@ -0,0 +1,119 @@
+#include "FrameProfiler.h"
+
+FrameProfiler::FrameProfiler()
+    : microsecondsPerTick(1000000.0 / (double)SDL_GetPerformanceFrequency()), frameStart(0),
+      previousFrameStart(0) {
+    clear();
+}
+
+void FrameProfiler::beginFrame() {
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        frameTicks[phase] = 0;
+    }
+    for (int counter = 0; counter < PROFILE_COUNTER_COUNT; counter++) {
+        frameCounts[counter] = 0;
+    }
+    previousFrameStart = frameStart;
+    frameStart = SDL_GetPerformanceCounter();
+}
+
+void FrameProfiler::endFrame() {
+    frameTicks[PROFILE_FRAME] = SDL_GetPerformanceCounter() - frameStart;
+
+    float* slot = history[historyNext];
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        lastFrame[phase] = frameTicks[phase] * microsecondsPerTick;
+        histograms[phase].record((uint64_t)(lastFrame[phase] + 0.5));
+        slot[phase] = (float)lastFrame[phase];
+    }
+    // The first frame has no previous start; count it as its own length
+    Uint64 interval = (previousFrameStart != 0) ? frameStart - previousFrameStart : frameTicks[PROFILE_FRAME];
+    frameIntervals[historyNext] = (float)(interval * microsecondsPerTick);
+    historyNext = (historyNext + 1) % PROFILE_HISTORY_FRAMES;
+    if (historySize < PROFILE_HISTORY_FRAMES) historySize++;
+
+    for (int counter = 0; counter < PROFILE_COUNTER_COUNT; counter++) {
+        lastFrameCounts[counter] = frameCounts[counter];
+        counterTotals[counter] += frameCounts[counter];
+    }
+    frameCount++;
+}
+
+void FrameProfiler::clear() {
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        histograms[phase].clear();
+        frameTicks[phase] = 0;
+        lastFrame[phase] = 0.0;
+    }
+    for (int counter = 0; counter < PROFILE_COUNTER_COUNT; counter++) {
+        frameCounts[counter] = 0;
+        lastFrameCounts[counter] = 0;
+        counterTotals[counter] = 0;
+    }
+    frameCount = 0;
+    historyNext = 0;
+    historySize = 0;
+    frameStart = 0;
+    previousFrameStart = 0;
+}
+
+void FrameProfiler::addTime(ProfilePhase phase, Uint64 counterTicks) {
+    frameTicks[phase] += counterTicks;
+}
+
+void FrameProfiler::addCount(ProfileCounter counter, uint64_t count) {
+    frameCounts[counter] += count;
+}
+
+const LatencyHistogram& FrameProfiler::getHistogram(ProfilePhase phase) const {
+    return histograms[phase];
+}
+
+double FrameProfiler::getLastFrameTime(ProfilePhase phase) const {
+    return lastFrame[phase];
+}
+
+uint64_t FrameProfiler::getFrameCount() const {
+    return frameCount;
+}
+
+int FrameProfiler::getHistorySize() const {
+    return historySize;
+}
+
+double FrameProfiler::getHistoryTime(int framesAgo, ProfilePhase phase) const {
+    if (framesAgo < 0 || framesAgo >= historySize) return 0.0;
+    int index = (historyNext - 1 - framesAgo + PROFILE_HISTORY_FRAMES) % PROFILE_HISTORY_FRAMES;
+    return history[index][phase];
+}
+
+double FrameProfiler::getFramesPerSecond() const {
+    double total = 0.0;
+    for (int i = 0; i < historySize; i++) {
+        total += frameIntervals[i];
+    }
+    return (total > 0.0) ? historySize * 1000000.0 / total : 0.0;
+}
+
+uint64_t FrameProfiler::getLastFrameCount(ProfileCounter counter) const {
+    return lastFrameCounts[counter];
+}
+
+uint64_t FrameProfiler::getCounterTotal(ProfileCounter counter) const {
+    return counterTotals[counter];
+}
+
+const char* FrameProfiler::getPhaseName(ProfilePhase phase) {
+    switch (phase) {
+        case PROFILE_EVENTS: return "events";
+        case PROFILE_UPDATE: return "update";
+        case PROFILE_AI: return "AI";
+        case PROFILE_RENDER: return "render";
+        case PROFILE_CLEAR: return "clearScreen";
+        case PROFILE_BOARD: return "renderBoard";
+        case PROFILE_TEXT: return "renderText";
+        case PROFILE_PRESENT: return "present";
+        case PROFILE_FRAME: return "frame";
+        default: return "?";
+    }
+}
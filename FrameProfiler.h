@@ -0,0 +1,108 @@
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <SDL2/SDL.h>
+
+#include <cstdint>
+#include "LatencyHistogram.h"
+
+// Frames kept for the profiler overlay's rolling graph
+const int PROFILE_HISTORY_FRAMES = 120;
+
+// Timed parts of a frame. PROFILE_UPDATE includes PROFILE_AI and
+// PROFILE_RENDER includes the renderer phases after it; the rest don't
+// overlap. PROFILE_FRAME is the whole frame from beginFrame to endFrame.
+enum ProfilePhase {
+    PROFILE_EVENTS,
+    PROFILE_UPDATE,
+    PROFILE_AI,
+    PROFILE_RENDER,
+    PROFILE_CLEAR,
+    PROFILE_BOARD,
+    PROFILE_TEXT,
+    PROFILE_PRESENT,
+    PROFILE_FRAME,
+    PROFILE_PHASE_COUNT
+};
+
+// Events counted per frame
+enum ProfileCounter {
+    PROFILE_DRAW_CALLS,
+    PROFILE_TEXTURE_UPLOADS,
+    PROFILE_COUNTER_COUNT
+};
+
+// CPU time per frame of each phase. Every timed section of a phase during
+// a frame is added up, and endFrame records the totals (in microseconds)
+// into a histogram per phase and into a short history for the overlay.
+class FrameProfiler {
+public:
+    FrameProfiler();
+
+    void beginFrame();
+    void endFrame();
+    void clear();
+
+    void addTime(ProfilePhase phase, Uint64 counterTicks);
+    void addCount(ProfileCounter counter, uint64_t count);
+
+    const LatencyHistogram& getHistogram(ProfilePhase phase) const;
+    double getLastFrameTime(ProfilePhase phase) const;  // Microseconds
+    uint64_t getFrameCount() const;
+
+    // framesAgo 0 is the last finished frame; up to getHistorySize() - 1
+    int getHistorySize() const;
+    double getHistoryTime(int framesAgo, ProfilePhase phase) const;
+    // From the time between frame starts over the history
+    double getFramesPerSecond() const;
+
+    uint64_t getLastFrameCount(ProfileCounter counter) const;
+    uint64_t getCounterTotal(ProfileCounter counter) const;
+
+    static const char* getPhaseName(ProfilePhase phase);
+
+private:
+    double microsecondsPerTick;
+    Uint64 frameStart;
+    Uint64 previousFrameStart;
+    Uint64 frameTicks[PROFILE_PHASE_COUNT];
+    double lastFrame[PROFILE_PHASE_COUNT];
+    LatencyHistogram histograms[PROFILE_PHASE_COUNT];
+    uint64_t frameCount;
+
+    float history[PROFILE_HISTORY_FRAMES][PROFILE_PHASE_COUNT];
+    float frameIntervals[PROFILE_HISTORY_FRAMES];
+    int historyNext;
+    int historySize;
+
+    uint64_t frameCounts[PROFILE_COUNTER_COUNT];
+    uint64_t lastFrameCounts[PROFILE_COUNTER_COUNT];
+    uint64_t counterTotals[PROFILE_COUNTER_COUNT];
+
+    FrameProfiler(const FrameProfiler&);
+    FrameProfiler& operator=(const FrameProfiler&);
+};
+
+// Adds the time until the end of its scope to a phase. A null profiler
+// makes it a no-op that doesn't read the clock.
+class ScopedProfileTimer {
+public:
+    ScopedProfileTimer(FrameProfiler* profiler, ProfilePhase phase)
+        : profiler(profiler), phase(phase), start(profiler ? SDL_GetPerformanceCounter() : 0) {}
+
+    ~ScopedProfileTimer() {
+        if (profiler) {
+            profiler->addTime(phase, SDL_GetPerformanceCounter() - start);
+        }
+    }
+
+private:
+    FrameProfiler* profiler;
+    ProfilePhase phase;
+    Uint64 start;
+
+    ScopedProfileTimer(const ScopedProfileTimer&);
+    ScopedProfileTimer& operator=(const ScopedProfileTimer&);
+};
+
+#endif
@@ -1,27 +1,45 @@
 #include "Game.h"
+#include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <chrono>
 #include <cmath>
+#include <ctime>
 
-Game::Game() : window(nullptr), sdlRenderer(nullptr), 
-               currentState(MENU), gameMode(PLAYER_VS_AI_MEDIUM), selectedGameMode(PLAYER_VS_AI_MEDIUM),
+Game::Game() : window(nullptr), sdlRenderer(nullptr), headless(false), 
+               currentState(MENU), lastScreen(MENU), gameMode(PLAYER_VS_AI_MEDIUM), selectedGameMode(PLAYER_VS_AI_MEDIUM),
                currentPlayer(PLAYER_X), humanPlayer(PLAYER_X), aiPlayer(PLAYER_O), 
-               gameRunning(true), gameEnded(false), lastFrameTime(0), gameEndTime(0),
+               gameRunning(true), gameEnded(false), needsRedraw(true), pendingAITimeUs(0), showHints(false), hintsValid(false), showProfiler(false), lastFrameTime(0), gameEndTime(0),
                lastAIMoveTime(0), gridStartX(0), gridStartY(0), cellSize(0),
                windowWidth(INITIAL_WINDOW_WIDTH), windowHeight(INITIAL_WINDOW_HEIGHT),
                boardSize(DEFAULT_BOARD_SIZE), winCondition(WIN_CONDITION_3X3),
                board(DEFAULT_BOARD_SIZE, WIN_CONDITION_3X3) {
     
     ai.setLevel(MEDIUM);
+    
+    // Hints get their own engine with a time budget, so analysing a large
+    // board costs a few frames at most and the player's AI keeps its settings
+    hintAI.setLevel(HARD);
+    hintAI.setPersistentCache(false);
+    hintAI.setTimeLimit(HINT_TIME_LIMIT);
 }
 
 Game::~Game() {
     cleanup();
 }
 
-bool Game::initialize() {
+bool Game::initialize(bool headlessMode) {
+    headless = headlessMode;
+    
     // Initialize SDL
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
+    Uint32 subsystems = headless ? SDL_INIT_VIDEO : SDL_INIT_VIDEO | SDL_INIT_AUDIO;
+    int initResult = SDL_Init(subsystems);
+    if (initResult < 0 && headless) {
+        // No display: render with the dummy video driver's software renderer
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+        initResult = SDL_Init(subsystems);
+    }
+    if (initResult < 0) {
         std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
     }
@@ -36,7 +54,7 @@ bool Game::initialize() {
     window = SDL_CreateWindow("Tic Tac Toe - SDL2 Edition",
                              SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
                              windowWidth, windowHeight,
-                             SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
+                             headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
     
     if (window == nullptr) {
         std::cerr << "Window could not be created! SDL_Error: " << SDL_GetError() << std::endl;
@@ -44,7 +62,8 @@ bool Game::initialize() {
     }
     
     // Create renderer
-    sdlRenderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    Uint32 rendererFlags = headless ? 0 : SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
+    sdlRenderer = SDL_CreateRenderer(window, -1, rendererFlags);
     if (sdlRenderer == nullptr) {
         std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
@@ -56,11 +75,31 @@ bool Game::initialize() {
         return false;
     }
     
+    // Benchmarks leave the player's statistics, logs and cache alone
+    if (headless) {
+        ai.setPersistentCache(false);
+        initializeButtons();
+        updateGridDimensions();
+        return true;
+    }
+    
     if (!audioManager.initialize()) {
         std::cerr << "Failed to initialize audio manager!" << std::endl;
         // Continue without audio
     }
     
+    if (!scoreTracker.openHistory(HISTORY_FILE)) {
+        std::cerr << "Failed to open game history " << HISTORY_FILE << std::endl;
+        // Continue with in-memory statistics
+    }
+    scoreTracker.openLatency(LATENCY_FILE);
+    ai.setLatencyTable(&scoreTracker.getMoveLatency());
+    
+    if (!gameLog.open(GAME_LOG_FILE)) {
+        std::cerr << "Failed to open game log " << GAME_LOG_FILE << std::endl;
+        // Continue without logging
+    }
+    
     // Initialize buttons
     initializeButtons();
     
@@ -78,11 +117,12 @@ void Game::initializeButtons() {
     gameButtons.clear();
     
     // Initialize menu buttons
-    menuButtons.emplace_back(300, 200, 200, 60, "Player vs Player");
-    menuButtons.emplace_back(300, 280, 200, 60, "vs AI (Easy)");
-    menuButtons.emplace_back(300, 360, 200, 60, "vs AI (Medium)");
-    menuButtons.emplace_back(300, 440, 200, 60, "vs AI (Hard)");
-    menuButtons.emplace_back(300, 520, 200, 60, "Quit");
+    menuButtons.emplace_back(300, 160, 200, 55, "Player vs Player");
+    menuButtons.emplace_back(300, 230, 200, 55, "vs AI (Easy)");
+    menuButtons.emplace_back(300, 300, 200, 55, "vs AI (Medium)");
+    menuButtons.emplace_back(300, 370, 200, 55, "vs AI (Hard)");
+    menuButtons.emplace_back(300, 440, 200, 55, "vs AI (Neural)");
+    menuButtons.emplace_back(300, 510, 200, 55, "Quit");
     
     // Initialize board size selection buttons with better positioning
     boardSizeButtons.emplace_back(300, 160, 200, 45, "3x3 Board");
@@ -95,6 +135,7 @@ void Game::initializeButtons() {
     settingsButtons.emplace_back(200, 200, 150, 50, "Easy AI");
     settingsButtons.emplace_back(375, 200, 150, 50, "Medium AI");
     settingsButtons.emplace_back(550, 200, 150, 50, "Hard AI");
+    settingsButtons.emplace_back(375, 270, 150, 50, "Neural AI");
     settingsButtons.emplace_back(350, 400, 100, 50, "Back");
     
     // Initialize game buttons
@@ -104,22 +145,73 @@ void Game::initializeButtons() {
 
 void Game::run() {
     while (gameRunning) {
+        // Nothing moves on its own: sleep until input or the AI's turn
+        if (!needsRedraw && !isAnimating()) {
+            waitForEvent();
+            lastFrameTime = SDL_GetTicks(); // Time spent asleep doesn't move animations
+        }
+        
         Uint32 frameStart = SDL_GetTicks();
         
-        handleEvents();
-        update();
-        render();
+        // Held for the whole frame, so toggling the overlay mid-frame is safe
+        FrameProfiler* frameProfiler = getActiveProfiler();
+        if (frameProfiler) frameProfiler->beginFrame();
         
-        // Cap frame rate
-        Uint32 frameTime = SDL_GetTicks() - frameStart;
-        if (frameTime < FRAME_DELAY) {
-            SDL_Delay(FRAME_DELAY - frameTime);
+        {
+            ScopedProfileTimer timer(frameProfiler, PROFILE_EVENTS);
+            handleEvents();
+        }
+        {
+            ScopedProfileTimer timer(frameProfiler, PROFILE_UPDATE);
+            update();
+        }
+        
+        bool rendering = needsRedraw || isAnimating();
+        if (rendering) {
+            ScopedProfileTimer timer(frameProfiler, PROFILE_RENDER);
+            render();
+            needsRedraw = false;
+        }
+        if (frameProfiler) frameProfiler->endFrame();
+        
+        if (rendering) {
+            // Cap frame rate
+            Uint32 frameTime = SDL_GetTicks() - frameStart;
+            if (frameTime < FRAME_DELAY) {
+                SDL_Delay(FRAME_DELAY - frameTime);
+            }
         }
         
         lastFrameTime = frameStart;
     }
 }
 
+void Game::waitForEvent() {
+    int timeout = IDLE_WAIT_TIMEOUT;
+    if (currentState == PLAYING && !gameEnded && gameMode != PLAYER_VS_PLAYER && currentPlayer == aiPlayer) {
+        Uint32 waited = SDL_GetTicks() - lastAIMoveTime;
+        timeout = (waited >= (Uint32)AI_MOVE_DELAY) ? 0 : (int)(AI_MOVE_DELAY - waited);
+    }
+    
+    // A null event leaves it queued for handleEvents
+    if (timeout > 0) {
+        SDL_WaitEventTimeout(nullptr, timeout);
+    }
+}
+
+bool Game::isAnimating() const {
+    // The profiler overlay graphs every frame
+    if (showProfiler || renderer.hasActiveAnimations()) return true;
+    
+    const std::vector<UIButton>* buttonLists[] = {&menuButtons, &boardSizeButtons, &gameButtons, &settingsButtons};
+    for (const auto* buttons : buttonLists) {
+        for (const auto& button : *buttons) {
+            if (button.isAnimating()) return true;
+        }
+    }
+    return false;
+}
+
 void Game::handleEvents() {
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
@@ -127,12 +219,23 @@ void Game::handleEvents() {
             gameRunning = false;
         }
         
-        if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_RESIZED) {
+        // Pointer movement only matters when it changes a button's hover state
+        if (e.type != SDL_MOUSEMOTION) {
+            needsRedraw = true;
+        }
+        
+        // Covers every size change, including ones the program makes itself
+        if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
             windowWidth = e.window.data1;
             windowHeight = e.window.data2;
             updateGridDimensions();
         }
         
+        // The renderer lost the contents of its render targets
+        if (e.type == SDL_RENDER_TARGETS_RESET) {
+            renderer.invalidateBoardLayer();
+        }
+        
         handleKeyboardEvents(e);
         
         switch (currentState) {
@@ -176,6 +279,22 @@ void Game::handleKeyboardEvents(SDL_Event& e) {
             case SDLK_m:
                 audioManager.setMuted(!audioManager.isMuted());
                 break;
+            case SDLK_h:
+                showHints = !showHints;
+                break;
+            case SDLK_s:
+                // Settings holds the AI level and the saved move-time percentiles
+                if (currentState == MENU) {
+                    currentState = SETTINGS;
+                } else if (currentState == SETTINGS) {
+                    currentState = MENU;
+                }
+                break;
+            case SDLK_p:
+                showProfiler = !showProfiler;
+                profiler.clear();
+                renderer.setProfiler(getActiveProfiler());
+                break;
         }
     }
 }
@@ -183,7 +302,7 @@ void Game::handleKeyboardEvents(SDL_Event& e) {
 void Game::handleMenuEvents(SDL_Event& e) {
     if (e.type == SDL_MOUSEMOTION) {
         for (auto& button : menuButtons) {
-            button.handleMouseMove(e.motion.x, e.motion.y);
+            if (button.handleMouseMove(e.motion.x, e.motion.y)) needsRedraw = true;
         }
     }
     
@@ -213,7 +332,12 @@ void Game::handleMenuEvents(SDL_Event& e) {
                         ai.setLevel(HARD);
                         currentState = BOARD_SIZE_SELECTION;
                         break;
-                    case 4: // Quit
+                    case 4: // vs AI (Neural)
+                        selectedGameMode = PLAYER_VS_AI_NEURAL;
+                        ai.setLevel(NEURAL);
+                        currentState = BOARD_SIZE_SELECTION;
+                        break;
+                    case 5: // Quit
                         gameRunning = false;
                         break;
                 }
@@ -228,7 +352,7 @@ void Game::handleMenuEvents(SDL_Event& e) {
 void Game::handleBoardSizeSelectionEvents(SDL_Event& e) {
     if (e.type == SDL_MOUSEMOTION) {
         for (auto& button : boardSizeButtons) {
-            button.handleMouseMove(e.motion.x, e.motion.y);
+            if (button.handleMouseMove(e.motion.x, e.motion.y)) needsRedraw = true;
         }
     }
     
@@ -274,7 +398,7 @@ void Game::handleBoardSizeSelectionEvents(SDL_Event& e) {
 void Game::handleGameEvents(SDL_Event& e) {
     if (e.type == SDL_MOUSEMOTION) {
         for (auto& button : gameButtons) {
-            button.handleMouseMove(e.motion.x, e.motion.y);
+            if (button.handleMouseMove(e.motion.x, e.motion.y)) needsRedraw = true;
         }
     }
     
@@ -317,7 +441,7 @@ void Game::handleGameEvents(SDL_Event& e) {
 void Game::handleSettingsEvents(SDL_Event& e) {
     if (e.type == SDL_MOUSEMOTION) {
         for (auto& button : settingsButtons) {
-            button.handleMouseMove(e.motion.x, e.motion.y);
+            if (button.handleMouseMove(e.motion.x, e.motion.y)) needsRedraw = true;
         }
     }
     
@@ -337,7 +461,10 @@ void Game::handleSettingsEvents(SDL_Event& e) {
                     case 2: // Hard AI
                         ai.setLevel(HARD);
                         break;
-                    case 3: // Back
+                    case 3: // Neural AI
+                        ai.setLevel(NEURAL);
+                        break;
+                    case 4: // Back
                         currentState = MENU;
                         break;
                 }
@@ -350,11 +477,37 @@ void Game::handleSettingsEvents(SDL_Event& e) {
 }
 
 void Game::update() {
-    // Update grid dimensions if window was resized
-    updateGridDimensions();
+    // Animations advance by the frame time, capped so a slow frame (an AI
+    // search) slows them down instead of skipping them
+    advanceAnimations(std::min((float)(SDL_GetTicks() - lastFrameTime), ANIMATION_MAX_STEP));
+    
+    if (currentState == PLAYING && !gameEnded) {
+        // Handle AI moves
+        if (gameMode != PLAYER_VS_PLAYER && currentPlayer == aiPlayer) {
+            // Add delay for AI moves to make them visible
+            if (SDL_GetTicks() - lastAIMoveTime >= (Uint32)AI_MOVE_DELAY) {
+                makeAIMove();
+                lastAIMoveTime = SDL_GetTicks();
+                needsRedraw = true;
+            }
+        }
+        
+        updateMoveHints();
+    }
+}
+
+void Game::advanceAnimations(float deltaMs) {
+    renderer.advanceAnimations(deltaMs);
+    
+    // Fade each new screen in
+    GameState screen = (currentState == GAME_OVER) ? PLAYING : currentState;
+    if (screen != lastScreen) {
+        renderer.startScreenTransition();
+        lastScreen = screen;
+    }
     
     // Update button animations
-    float deltaTime = (SDL_GetTicks() - lastFrameTime) / 1000.0f;
+    float deltaTime = deltaMs / 1000.0f;
     for (auto& button : menuButtons) {
         button.updateAnimation(deltaTime);
     }
@@ -367,19 +520,6 @@ void Game::update() {
     for (auto& button : settingsButtons) {
         button.updateAnimation(deltaTime);
     }
-    
-    if (currentState == PLAYING && !gameEnded) {
-        // Handle AI moves
-        if (gameMode != PLAYER_VS_PLAYER && currentPlayer == aiPlayer) {
-            // Add delay for AI moves to make them visible
-            if (SDL_GetTicks() - lastAIMoveTime > 500) { // 500ms delay
-                makeAIMove();
-                lastAIMoveTime = SDL_GetTicks();
-            }
-        }
-        
-        checkGameEnd();
-    }
 }
 
 void Game::render() {
@@ -393,6 +533,7 @@ void Game::render() {
                     case EASY: difficultyText += "Easy"; break;
                     case MEDIUM: difficultyText += "Medium"; break;
                     case HARD: difficultyText += "Hard"; break;
+                    case NEURAL: difficultyText += "Neural"; break;
                 }
                 difficultyText += " | " + scoreTracker.getStatsString();
                 renderer.renderMenu(menuButtons, difficultyText);
@@ -403,21 +544,109 @@ void Game::render() {
             break;
         case PLAYING:
         case GAME_OVER:
-            renderer.renderGame(board, gameButtons, statusMessage, currentPlayer, gameEnded);
+            renderer.renderGame(board, winInfo, gameButtons, statusMessage, turnMessage, currentPlayer);
+            if (showHints && hintsValid && !gameEnded) {
+                renderer.renderMoveHints(moveHints);
+            }
             break;
         case SETTINGS:
-            renderer.renderSettings(settingsButtons, ai.getLevel());
+            {
+                std::vector<std::string> latencyLines;
+                for (int size = LATENCY_MIN_BOARD_SIZE; size <= LATENCY_MAX_BOARD_SIZE; size++) {
+                    latencyLines.push_back(scoreTracker.getLatencyString(ai.getLevel(), size));
+                }
+                renderer.renderSettings(settingsButtons, ai.getLevel(), latencyLines);
+            }
             break;
     }
     
+    if (showProfiler) {
+        renderer.renderProfilerOverlay(profiler);
+    }
+    
     renderer.present();
 }
 
+void Game::runRenderBenchmark(int framesPerScene) {
+    profiler.clear();
+    renderer.setProfiler(&profiler);
+    
+    SDL_RendererInfo info;
+    const char* rendererName = (SDL_GetRendererInfo(sdlRenderer, &info) == 0) ? info.name : "unknown";
+    std::cout << "Render benchmark: " << framesPerScene << " frames per scene, " << windowWidth << "x"
+              << windowHeight << ", " << rendererName << " renderer" << std::endl;
+    Uint64 start = SDL_GetPerformanceCounter();
+    
+    // Menus, with the pointer moving to another button now and then
+    GameState menus[] = {MENU, BOARD_SIZE_SELECTION, SETTINGS};
+    for (GameState state : menus) {
+        currentState = state;
+        std::vector<UIButton>& buttons = (state == MENU) ? menuButtons :
+                                         (state == SETTINGS) ? settingsButtons : boardSizeButtons;
+        for (int frame = 0; frame < framesPerScene; frame++) {
+            if (frame % RENDER_BENCH_HOVER_INTERVAL == 0) {
+                SDL_Rect target = buttons[(frame / RENDER_BENCH_HOVER_INTERVAL) % buttons.size()].getRect();
+                for (auto& button : buttons) {
+                    button.handleMouseMove(target.x + target.w / 2, target.y + target.h / 2);
+                }
+            }
+            renderBenchmarkFrame();
+        }
+    }
+    
+    // A game at every board size, filled in row by row until someone wins
+    gameMode = PLAYER_VS_PLAYER;
+    for (int size = MIN_BOARD_SIZE; size <= MAX_BOARD_SIZE; size++) {
+        setBoardSize(size);
+        startNewGame();
+        int nextCell = 0;
+        for (int frame = 0; frame < framesPerScene; frame++) {
+            if (frame % RENDER_BENCH_MOVE_INTERVAL == 0 && !gameEnded && nextCell < size * size) {
+                makeMove(nextCell / size, nextCell % size);
+                nextCell++;
+            }
+            renderBenchmarkFrame();
+        }
+    }
+    
+    double seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    double frames = (double)profiler.getFrameCount();
+    std::cout << profiler.getFrameCount() << " frames in " << std::fixed << std::setprecision(2) << seconds
+              << "s (" << std::setprecision(0) << frames / seconds << " fps), "
+              << std::setprecision(1) << profiler.getCounterTotal(PROFILE_DRAW_CALLS) / frames
+              << " draw calls and " << std::setprecision(2) << profiler.getCounterTotal(PROFILE_TEXTURE_UPLOADS) / frames
+              << " texture uploads per frame" << std::endl;
+    // The game loop phases before PROFILE_RENDER don't run here
+    for (int phase = PROFILE_RENDER; phase < PROFILE_PHASE_COUNT; phase++) {
+        std::cout << "  " << std::left << std::setw(13) << FrameProfiler::getPhaseName((ProfilePhase)phase)
+                  << profiler.getHistogram((ProfilePhase)phase).getSummary() << std::endl;
+    }
+    
+    renderer.setProfiler(nullptr);
+}
+
+// One frame on a fixed time step, so every run animates the same frames
+void Game::renderBenchmarkFrame() {
+    profiler.beginFrame();
+    advanceAnimations((float)FRAME_DELAY);
+    {
+        ScopedProfileTimer timer(&profiler, PROFILE_RENDER);
+        render();
+    }
+    profiler.endFrame();
+}
+
+FrameProfiler* Game::getActiveProfiler() {
+    return showProfiler ? &profiler : nullptr;
+}
+
 void Game::startNewGame() {
     board.reset();
     currentPlayer = PLAYER_X;
     gameEnded = false;
     statusMessage = "";
+    winInfo = WinInfo();
+    hintsValid = false;
     currentState = PLAYING;
     gameEndTime = 0;
     lastAIMoveTime = SDL_GetTicks();
@@ -433,17 +662,35 @@ void Game::startNewGame() {
         humanPlayer = PLAYER_X;
         aiPlayer = PLAYER_O;
     }
+    
+    currentRecord.boardSize = boardSize;
+    currentRecord.winCondition = winCondition;
+    currentRecord.mode = gameMode;
+    currentRecord.aiLevel = (gameMode == PLAYER_VS_PLAYER) ? -1 : ai.getLevel();
+    currentRecord.moves.clear();
+    pendingAITimeUs = 0;
+    scoreTracker.setGameContext(currentRecord.mode, boardSize, currentRecord.aiLevel);
+    updateTurnMessage();
 }
 
 void Game::makeMove(int row, int col) {
     if (board.makeMove(row, col, currentPlayer)) {
+        GameLogMove logMove;
+        logMove.cell = row * boardSize + col;
+        logMove.aiTimeUs = pendingAITimeUs;
+        currentRecord.moves.push_back(logMove);
+        pendingAITimeUs = 0;
+        
         audioManager.playSound(SOUND_PIECE_PLACE);
         renderer.startPieceAnimation(row, col, currentPlayer);
+        hintsValid = false;
         
+        // The only place the board is scanned: once per move
         checkGameEnd();
         if (!gameEnded) {
             switchPlayer();
         }
+        updateTurnMessage();
     }
 }
 
@@ -451,8 +698,17 @@ void Game::switchPlayer() {
     currentPlayer = (currentPlayer == PLAYER_X) ? PLAYER_O : PLAYER_X;
 }
 
+void Game::updateTurnMessage() {
+    if (gameEnded) {
+        turnMessage.clear();
+    } else {
+        turnMessage = "Current Player: ";
+        turnMessage += (currentPlayer == PLAYER_X) ? "X" : "O";
+    }
+}
+
 void Game::checkGameEnd() {
-    WinInfo winInfo = board.checkWin();
+    winInfo = board.checkWin();
     
     if (winInfo.hasWinner) {
         gameEnded = true;
@@ -461,6 +717,8 @@ void Game::checkGameEnd() {
         
         // Record the win
         scoreTracker.recordWin(winInfo.winner);
+        recordFinishedGame(winInfo.winner);
+        ai.saveCache();
         
         // Start win animation
         renderer.startWinLineAnimation(winInfo.winningCells, boardSize);
@@ -485,19 +743,45 @@ void Game::checkGameEnd() {
         
         // Record the draw
         scoreTracker.recordDraw();
+        recordFinishedGame(EMPTY);
+        ai.saveCache();
         
         audioManager.playSound(SOUND_DRAW);
     }
 }
 
 void Game::makeAIMove() {
-    auto move = ai.getMove(board, aiPlayer);
+    auto start = std::chrono::steady_clock::now();
+    std::pair<int, int> move;
+    {
+        ScopedProfileTimer timer(getActiveProfiler(), PROFILE_AI);
+        move = ai.getMove(board, aiPlayer);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
     
     if (move.first != -1 && move.second != -1) {
+        pendingAITimeUs = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
         makeMove(move.first, move.second);
     }
 }
 
+void Game::recordFinishedGame(CellState winner) {
+    currentRecord.winner = winner;
+    currentRecord.timestamp = (uint64_t)std::time(nullptr);
+    gameLog.append(currentRecord);
+    scoreTracker.saveLatency();
+}
+
+void Game::updateMoveHints() {
+    // Analyse once per position, and only while a human is to move
+    if (!showHints || hintsValid || gameEnded) return;
+    if (gameMode != PLAYER_VS_PLAYER && currentPlayer != humanPlayer) return;
+    
+    ScopedProfileTimer timer(getActiveProfiler(), PROFILE_AI);
+    moveHints = hintAI.analyze(board, currentPlayer);
+    hintsValid = true;
+}
+
 std::pair<int, int> Game::getGridPosition(int mouseX, int mouseY) {
     if (mouseX < gridStartX || mouseX >= gridStartX + cellSize * boardSize ||
         mouseY < gridStartY || mouseY >= gridStartY + cellSize * boardSize) {
@@ -524,22 +808,13 @@ void Game::updateGridDimensions() {
 
 void Game::setBoardSize(int size) {
     boardSize = size;
-    winCondition = getWinConditionForSize(size);
+    winCondition = getDefaultWinCondition(size);
     board.resize(boardSize, winCondition);
     updateGridDimensions();
 }
 
-int Game::getWinConditionForSize(int size) {
-    switch (size) {
-        case 3: return WIN_CONDITION_3X3;
-        case 4: return WIN_CONDITION_4X4;
-        case 5: return WIN_CONDITION_5X5;
-        case 6: return WIN_CONDITION_6X6;
-        default: return 3;
-    }
-}
-
 void Game::cleanup() {
+    ai.saveCache();
     renderer.cleanup();
     audioManager.cleanup();
     
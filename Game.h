@@ -14,13 +14,16 @@
 #include "AudioManager.h"
 #include "UIButton.h"
 #include "ScoreTracker.h"
+#include "GameLog.h"
+#include "FrameProfiler.h"
 #include "Constants.h"
 
 enum GameMode {
     PLAYER_VS_PLAYER,
     PLAYER_VS_AI_EASY,
     PLAYER_VS_AI_MEDIUM,
-    PLAYER_VS_AI_HARD
+    PLAYER_VS_AI_HARD,
+    PLAYER_VS_AI_NEURAL
 };
 
 enum GameState {
@@ -36,8 +39,13 @@ public:
     Game();
     ~Game();
     
-    bool initialize();
+    // Headless: hidden window (dummy video driver without a display), no
+    // VSync, audio or saved files; for runRenderBenchmark
+    bool initialize(bool headless = false);
     void run();
+    // Renders scripted menus and games at every board size, then prints
+    // per-phase frame time percentiles
+    void runRenderBenchmark(int framesPerScene);
     void cleanup();
     
 private:
@@ -52,37 +60,49 @@ private:
     void handleGameEvents(SDL_Event& e);
     void handleSettingsEvents(SDL_Event& e);
     void handleKeyboardEvents(SDL_Event& e);
+    void waitForEvent();
+    bool isAnimating() const;
+    void advanceAnimations(float deltaMs);
+    void renderBenchmarkFrame();
+    FrameProfiler* getActiveProfiler();
     
     // Game logic
     void startNewGame();
     void makeMove(int row, int col);
     void switchPlayer();
+    void updateTurnMessage();
     void checkGameEnd();
     void resetGame();
     
     // AI logic
     void makeAIMove();
+    void recordFinishedGame(CellState winner);
+    void updateMoveHints();
     
     // Utility functions
     std::pair<int, int> getGridPosition(int mouseX, int mouseY);
     void updateGridDimensions();
     void initializeButtons();
     void setBoardSize(int size);
-    int getWinConditionForSize(int size);
     
     // SDL components
     SDL_Window* window;
     SDL_Renderer* sdlRenderer;
+    bool headless;
     
     // Game components
     Board board;
     AI ai;
+    AI hintAI;           // Time-limited search behind the move hints
     Renderer renderer;
     AudioManager audioManager;
     ScoreTracker scoreTracker;
+    GameLogWriter gameLog;
+    FrameProfiler profiler;
     
     // Game state
     GameState currentState;
+    GameState lastScreen;      // Screen last faded in; GAME_OVER shares PLAYING's
     GameMode gameMode;
     GameMode selectedGameMode; // Store selected mode before board size selection
     CellState currentPlayer;
@@ -90,7 +110,21 @@ private:
     CellState aiPlayer;
     bool gameRunning;
     bool gameEnded;
+    bool needsRedraw;   // Something on screen changed since the last frame
     std::string statusMessage;
+    std::string turnMessage;   // "Current Player: X", empty once the game ends
+    WinInfo winInfo;           // Result of the last move, kept for the renderer
+    
+    // Record of the game in progress, appended to the game log when it ends
+    GameRecord currentRecord;
+    uint32_t pendingAITimeUs; // AI thinking time for the move being made
+    
+    // Move hints (score heatmap for the player to move)
+    bool showHints;
+    bool hintsValid;
+    std::vector<MoveAnalysis> moveHints;
+    
+    bool showProfiler;   // Frame profiler overlay; nothing is timed while it is hidden
     
     // Board configuration
     int boardSize;
@@ -0,0 +1,228 @@
+#include "GameLog.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    const char LOG_MAGIC[4] = {'T', 'T', 'T', 'L'};
+    const uint32_t LOG_VERSION = 1;
+    const size_t LOG_HEADER_SIZE = 8;     // Magic + version
+    const size_t MAX_RECORD_SIZE = 1024;  // 36 moves of at most 10 bytes each, plus the header
+
+    void writeVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out += (char)((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out += (char)value;
+    }
+
+    // Decodes a varint at pos, advancing it; false if it runs past end
+    bool readVarint(const unsigned char* data, size_t end, size_t& pos, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; pos < end && shift < 64; shift += 7) {
+            unsigned char byte = data[pos++];
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+}
+
+GameLogWriter::GameLogWriter() {}
+
+bool GameLogWriter::open(const std::string& filename) {
+    close();
+
+    // Check an existing log, and cut off a record left half-written by a
+    // crash so that new records stay reachable
+    bool isNew = true;
+    bool tornTail = false;
+    size_t validLength = 0;
+    {
+        GameLogReader reader;
+        if (reader.open(filename)) {
+            isNew = false;
+            while (reader.skip()) {}
+            validLength = reader.getOffset();
+            tornTail = validLength < reader.getSize();
+        } else {
+            std::ifstream existing(filename, std::ios::binary | std::ios::ate);
+            if (existing.is_open() && existing.tellg() > 0) {
+                return false; // Not a log we can extend
+            }
+        }
+    }
+
+    // Only once the reader's mapping is gone: Windows can't replace a mapped file
+    if (tornTail && !truncate(filename, validLength)) {
+        return false;
+    }
+
+    file.open(filename, std::ios::binary | std::ios::app);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    if (isNew) {
+        file.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+        file.write(reinterpret_cast<const char*>(&LOG_VERSION), sizeof(LOG_VERSION));
+        file.flush();
+    }
+    buffer.reserve(MAX_RECORD_SIZE);
+    payload.reserve(MAX_RECORD_SIZE);
+    return (bool)file;
+}
+
+bool GameLogWriter::truncate(const std::string& filename, size_t length) {
+    std::string tempName = filename + ".tmp";
+    {
+        MappedFile source;
+        std::ofstream out(tempName, std::ios::binary | std::ios::trunc);
+        if (!source.open(filename) || !out.is_open() ||
+            !out.write(reinterpret_cast<const char*>(source.data()), (std::streamsize)length)) {
+            out.close();
+            std::remove(tempName.c_str());
+            return false;
+        }
+    }
+
+    if (!replaceFile(tempName, filename)) {
+        std::remove(tempName.c_str());
+        return false;
+    }
+    return true;
+}
+
+void GameLogWriter::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+    file.clear();
+}
+
+bool GameLogWriter::isOpen() const {
+    return file.is_open();
+}
+
+bool GameLogWriter::append(const GameRecord& record) {
+    if (!file.is_open()) return false;
+
+    // Payload: size, win condition, mode, AI level + 1, winner, then
+    // varints for the timestamp, the move count and (cell, AI time) pairs
+    payload.clear();
+    payload += (char)record.boardSize;
+    payload += (char)record.winCondition;
+    payload += (char)record.mode;
+    payload += (char)(record.aiLevel + 1);
+    payload += (char)record.winner;
+    writeVarint(payload, record.timestamp);
+    writeVarint(payload, record.moves.size());
+    for (const auto& move : record.moves) {
+        writeVarint(payload, (uint64_t)move.cell);
+        writeVarint(payload, move.aiTimeUs);
+    }
+
+    buffer.clear();
+    writeVarint(buffer, payload.size());
+    buffer += payload;
+
+    file.write(buffer.data(), (std::streamsize)buffer.size());
+    file.flush();
+    return (bool)file;
+}
+
+GameLogReader::GameLogReader() : offset(0) {}
+
+bool GameLogReader::open(const std::string& filename) {
+    close();
+    if (!file.open(filename)) {
+        return false;
+    }
+
+    uint32_t version = 0;
+    if (file.size() < LOG_HEADER_SIZE) {
+        file.close();
+        return false;
+    }
+    std::memcpy(&version, file.data() + 4, sizeof(version));
+    if (std::memcmp(file.data(), LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 || version != LOG_VERSION) {
+        file.close();
+        return false;
+    }
+
+    offset = LOG_HEADER_SIZE;
+    return true;
+}
+
+void GameLogReader::close() {
+    file.close();
+    offset = 0;
+}
+
+size_t GameLogReader::getOffset() const {
+    return offset;
+}
+
+size_t GameLogReader::getSize() const {
+    return file.size();
+}
+
+void GameLogReader::rewind() {
+    offset = file.isOpen() ? LOG_HEADER_SIZE : 0;
+}
+
+bool GameLogReader::readRecordBounds(size_t& payloadStart, size_t& payloadEnd) const {
+    if (!file.isOpen()) return false;
+
+    size_t pos = offset;
+    uint64_t length = 0;
+    if (!readVarint(file.data(), file.size(), pos, length) || length > file.size() - pos) {
+        return false; // End of log, or a record cut short by a crash
+    }
+
+    payloadStart = pos;
+    payloadEnd = pos + (size_t)length;
+    return true;
+}
+
+bool GameLogReader::skip() {
+    size_t payloadStart, payloadEnd;
+    if (!readRecordBounds(payloadStart, payloadEnd)) return false;
+
+    offset = payloadEnd;
+    return true;
+}
+
+bool GameLogReader::next(GameRecord& record) {
+    size_t payloadStart, payloadEnd;
+    if (!readRecordBounds(payloadStart, payloadEnd) || payloadEnd - payloadStart < 5) return false;
+
+    const unsigned char* data = file.data();
+    size_t pos = payloadStart;
+    record.boardSize = data[pos++];
+    record.winCondition = data[pos++];
+    record.mode = data[pos++];
+    record.aiLevel = (int)data[pos++] - 1;
+    record.winner = (CellState)data[pos++];
+
+    uint64_t moveCount = 0;
+    if (!readVarint(data, payloadEnd, pos, record.timestamp) || !readVarint(data, payloadEnd, pos, moveCount)) {
+        return false;
+    }
+
+    if (moveCount > (payloadEnd - pos) / 2) return false; // At least two bytes per move
+
+    record.moves.resize((size_t)moveCount);
+    for (auto& move : record.moves) {
+        uint64_t cell = 0;
+        uint64_t aiTime = 0;
+        if (!readVarint(data, payloadEnd, pos, cell) || !readVarint(data, payloadEnd, pos, aiTime)) {
+            return false;
+        }
+        move.cell = (int)cell;
+        move.aiTimeUs = (uint32_t)aiTime;
+    }
+
+    offset = payloadEnd;
+    return true;
+}
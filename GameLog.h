@@ -0,0 +1,81 @@
+#ifndef GAMELOG_H
+#define GAMELOG_H
+
+#include "Board.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Default log written by the game
+const char* const GAME_LOG_FILE = "game_log.bin";
+
+struct GameLogMove {
+    int cell;           // row * boardSize + col
+    uint32_t aiTimeUs;  // Time the AI spent choosing this move (0 for human moves)
+};
+
+// One finished game
+struct GameRecord {
+    int boardSize;
+    int winCondition;
+    int mode;           // GameMode of the front end that played it
+    int aiLevel;        // AILevel, or -1 if no AI took part
+    CellState winner;   // EMPTY for a draw
+    uint64_t timestamp; // Seconds since the epoch
+    std::vector<GameLogMove> moves;
+
+    GameRecord() : boardSize(0), winCondition(0), mode(0), aiLevel(-1), winner(EMPTY), timestamp(0) {}
+};
+
+// Appends games to a binary log. Each game is encoded into one buffer (a
+// varint length prefix, then a few header bytes and varint moves) and
+// written with a single write, so a crash can at worst truncate the last
+// record, which readers skip.
+class GameLogWriter {
+public:
+    GameLogWriter();
+
+    // Open for appending, creating the file with its header if needed
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const;
+
+    bool append(const GameRecord& record);
+
+private:
+    std::ofstream file;
+    std::string buffer;   // Reused encoding buffers
+    std::string payload;
+
+    static bool truncate(const std::string& filename, size_t length);
+};
+
+// Iterates a game log through a read-only memory mapping. Records are
+// decoded straight from the mapping into a caller-owned GameRecord whose
+// move vector is reused, so scanning does no per-game allocation; skip()
+// steps over a record using only its length prefix.
+class GameLogReader {
+public:
+    GameLogReader();
+
+    bool open(const std::string& filename);
+    void close();
+
+    // Decode the next game; false at the end of the log (or a truncated tail)
+    bool next(GameRecord& record);
+    bool skip();
+    void rewind();
+
+    size_t getOffset() const;  // Bytes consumed so far, header included
+    size_t getSize() const;
+
+private:
+    MappedFile file;
+    size_t offset;
+
+    bool readRecordBounds(size_t& payloadStart, size_t& payloadEnd) const;
+};
+
+#endif
@@ -0,0 +1,126 @@
+#include "GlyphAtlas.h"
+
+GlyphAtlas::GlyphAtlas()
+    : font(nullptr), texture(nullptr), atlasWidth(0), atlasHeight(0), lineHeight(0), useKerning(false) {}
+
+GlyphAtlas::~GlyphAtlas() {
+    release();
+}
+
+bool GlyphAtlas::build(SDL_Renderer* renderer, TTF_Font* ttfFont) {
+    release();
+    if (!renderer || !ttfFont) return false;
+
+    // Rasterize each glyph the way TTF renders it inside a string, then pack
+    // them into rows
+    SDL_Surface* surfaces[GLYPH_ATLAS_CHAR_COUNT] = {nullptr};
+    int x = 0, y = 0, rowHeight = 0;
+    SDL_Color white = {255, 255, 255, 255};
+    for (int i = 0; i < GLYPH_ATLAS_CHAR_COUNT; i++) {
+        Uint16 ch = (Uint16)(GLYPH_ATLAS_FIRST_CHAR + i);
+        int minX, maxX, minY, maxY, advance;
+        if (TTF_GlyphMetrics(ttfFont, ch, &minX, &maxX, &minY, &maxY, &advance) != 0) advance = 0;
+
+        glyphs[i].advance = advance;
+        glyphs[i].source = {0, 0, 0, 0};
+        surfaces[i] = TTF_RenderGlyph_Blended(ttfFont, ch, white);
+        if (!surfaces[i]) continue;
+
+        if (x + surfaces[i]->w > GLYPH_ATLAS_WIDTH) {
+            x = 0;
+            y += rowHeight + 1;
+            rowHeight = 0;
+        }
+        glyphs[i].source = {x, y, surfaces[i]->w, surfaces[i]->h};
+        x += surfaces[i]->w + 1;  // One pixel gap so filtering doesn't bleed between glyphs
+        if (surfaces[i]->h > rowHeight) rowHeight = surfaces[i]->h;
+    }
+    atlasWidth = GLYPH_ATLAS_WIDTH;
+    atlasHeight = y + rowHeight;
+
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlas) {
+        SDL_FillRect(atlas, nullptr, SDL_MapRGBA(atlas->format, 255, 255, 255, 0));
+    }
+    for (int i = 0; i < GLYPH_ATLAS_CHAR_COUNT; i++) {
+        if (!surfaces[i]) continue;
+        if (atlas) {
+            SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);  // Copy alpha as is
+            SDL_BlitSurface(surfaces[i], nullptr, atlas, &glyphs[i].source);
+        }
+        SDL_FreeSurface(surfaces[i]);
+    }
+    if (!atlas) return false;
+
+    texture = SDL_CreateTextureFromSurface(renderer, atlas);
+    SDL_FreeSurface(atlas);
+    if (!texture) return false;
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    font = ttfFont;
+    lineHeight = TTF_FontHeight(ttfFont);
+    useKerning = TTF_GetFontKerning(ttfFont) != 0;
+    return true;
+}
+
+void GlyphAtlas::release() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+    font = nullptr;
+}
+
+bool GlyphAtlas::isReady() const {
+    return texture != nullptr;
+}
+
+bool GlyphAtlas::canDraw(const std::string& text) const {
+    if (!texture) return false;
+    for (char ch : text) {
+        if ((unsigned char)ch < GLYPH_ATLAS_FIRST_CHAR || (unsigned char)ch > GLYPH_ATLAS_LAST_CHAR) return false;
+    }
+    return true;
+}
+
+int GlyphAtlas::getKerning(char previous, char current) const {
+    if (!useKerning || previous == 0) return 0;
+    return TTF_GetFontKerningSizeGlyphs(font, (Uint16)previous, (Uint16)current);
+}
+
+void GlyphAtlas::measure(const std::string& text, int& width, int& height) const {
+    width = 0;
+    height = lineHeight;
+
+    int penX = 0;
+    char previous = 0;
+    for (char ch : text) {
+        const Glyph& glyph = glyphs[ch - GLYPH_ATLAS_FIRST_CHAR];
+        penX += getKerning(previous, ch);
+        if (penX + glyph.source.w > width) width = penX + glyph.source.w;
+        penX += glyph.advance;
+        previous = ch;
+    }
+}
+
+void GlyphAtlas::draw(RenderBatch& batch, RenderLayer layer, const std::string& text, float x, float y,
+                      float scale, SDL_Color color) const {
+    if (!texture) return;
+
+    float penX = x;
+    char previous = 0;
+    for (char ch : text) {
+        const Glyph& glyph = glyphs[ch - GLYPH_ATLAS_FIRST_CHAR];
+        penX += getKerning(previous, ch) * scale;
+        previous = ch;
+
+        if (glyph.source.w > 0) {
+            SDL_FRect dest = {penX, y, glyph.source.w * scale, glyph.source.h * scale};
+            batch.addTexturedRect(layer, texture, dest, (float)glyph.source.x / atlasWidth,
+                                  (float)glyph.source.y / atlasHeight,
+                                  (float)(glyph.source.x + glyph.source.w) / atlasWidth,
+                                  (float)(glyph.source.y + glyph.source.h) / atlasHeight, color);
+        }
+        penX += glyph.advance * scale;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <string>
+#include "RenderBatch.h"
+
+// Glyph atlas settings
+const int GLYPH_ATLAS_FIRST_CHAR = 32;    // Printable ASCII
+const int GLYPH_ATLAS_LAST_CHAR = 126;
+const int GLYPH_ATLAS_CHAR_COUNT = GLYPH_ATLAS_LAST_CHAR - GLYPH_ATLAS_FIRST_CHAR + 1;
+const int GLYPH_ATLAS_WIDTH = 512;        // Rows of glyphs wrap at this width
+
+// Every printable ASCII glyph of one font, rasterized once (white,
+// anti-aliased) into a single texture. A string becomes textured quads in
+// a RenderBatch, tinted by vertex color and spaced by the font's advances
+// and kerning, so text that changes every frame shares the batch's draw
+// calls and needs no surface or texture work.
+class GlyphAtlas {
+public:
+    GlyphAtlas();
+    ~GlyphAtlas();
+
+    bool build(SDL_Renderer* renderer, TTF_Font* font);
+    void release();
+    bool isReady() const;
+
+    // True if every character of the text is in the atlas
+    bool canDraw(const std::string& text) const;
+    // Size the text would have when rendered by TTF at scale 1
+    void measure(const std::string& text, int& width, int& height) const;
+    // Queue the text with its top-left corner at (x, y)
+    void draw(RenderBatch& batch, RenderLayer layer, const std::string& text, float x, float y, float scale,
+              SDL_Color color) const;
+
+private:
+    struct Glyph {
+        SDL_Rect source;    // Where the glyph's TTF rendering sits in the atlas
+        int advance;
+    };
+
+    TTF_Font* font;
+    SDL_Texture* texture;
+    int atlasWidth, atlasHeight;
+    int lineHeight;
+    bool useKerning;
+    Glyph glyphs[GLYPH_ATLAS_CHAR_COUNT];
+
+    GlyphAtlas(const GlyphAtlas&);
+    GlyphAtlas& operator=(const GlyphAtlas&);
+
+    int getKerning(char previous, char current) const;
+};
+
+#endif
@@ -0,0 +1,236 @@
+#include "HistoryStore.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    const char HISTORY_MAGIC[4] = {'T', 'T', 'T', 'H'};
+    const uint32_t HISTORY_VERSION = 1;
+
+    struct HistoryHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t slotCount;
+        uint32_t reserved;
+        uint64_t sequence;      // Last journal entry included in this checkpoint
+    };
+
+    struct JournalEntry {
+        uint64_t sequence;
+        uint8_t mode;
+        uint8_t boardSize;
+        uint8_t levelSlot;      // AI level + 1
+        uint8_t winner;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(HistoryHeader) == 24, "history header layout");
+    static_assert(sizeof(HistoryAggregate) == 24, "history aggregate layout");
+    static_assert(sizeof(JournalEntry) == 16, "journal entry layout");
+}
+
+HistoryStore::HistoryStore() : slots(HISTORY_SLOT_COUNT), sequence(0), journalEntries(0) {}
+
+int HistoryStore::getSlot(int mode, int boardSize, int aiLevel) {
+    int levelSlot = aiLevel + 1;
+    if (mode < 0 || mode >= HISTORY_MAX_MODES || boardSize < HISTORY_MIN_BOARD_SIZE ||
+        boardSize > HISTORY_MAX_BOARD_SIZE || levelSlot < 0 || levelSlot >= HISTORY_MAX_LEVELS) {
+        return -1;
+    }
+    int sizeCount = HISTORY_MAX_BOARD_SIZE - HISTORY_MIN_BOARD_SIZE + 1;
+    return (mode * sizeCount + (boardSize - HISTORY_MIN_BOARD_SIZE)) * HISTORY_MAX_LEVELS + levelSlot;
+}
+
+bool HistoryStore::open(const std::string& filename) {
+    close();
+    clear();
+    sequence = 0;
+    checkpointFile = filename;
+
+    loadCheckpoint();
+    bool journalIntact = replayJournal(sequence);
+
+    journal.open(checkpointFile + ".journal", std::ios::binary | std::ios::app);
+    if (!journalIntact) {
+        checkpoint(); // Don't append after a torn entry
+    }
+    return journal.is_open();
+}
+
+void HistoryStore::close() {
+    if (journal.is_open()) {
+        journal.close();
+    }
+    journal.clear();
+    checkpointFile.clear();
+}
+
+bool HistoryStore::isOpen() const {
+    return journal.is_open();
+}
+
+bool HistoryStore::loadCheckpoint() {
+    MappedFile file;
+    if (!file.open(checkpointFile)) {
+        return false;
+    }
+
+    HistoryHeader header;
+    size_t expectedSize = sizeof(header) + HISTORY_SLOT_COUNT * sizeof(HistoryAggregate);
+    if (file.size() < expectedSize) {
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC)) != 0 || header.version != HISTORY_VERSION ||
+        header.slotCount != (uint32_t)HISTORY_SLOT_COUNT) {
+        return false;
+    }
+
+    std::memcpy(&slots[0], file.data() + sizeof(header), HISTORY_SLOT_COUNT * sizeof(HistoryAggregate));
+    totals = HistoryAggregate();
+    for (const auto& slot : slots) {
+        totals.xWins += slot.xWins;
+        totals.oWins += slot.oWins;
+        totals.draws += slot.draws;
+    }
+    sequence = header.sequence;
+    return true;
+}
+
+bool HistoryStore::replayJournal(uint64_t checkpointSequence) {
+    MappedFile file;
+    if (!file.open(checkpointFile + ".journal")) {
+        return true;
+    }
+
+    // A partial entry at the end (crash during a write) is ignored
+    size_t count = file.size() / sizeof(JournalEntry);
+    for (size_t i = 0; i < count; i++) {
+        JournalEntry entry;
+        std::memcpy(&entry, file.data() + i * sizeof(JournalEntry), sizeof(entry));
+        if (entry.sequence <= checkpointSequence) continue;  // Already in the checkpoint
+
+        int slot = getSlot(entry.mode, entry.boardSize, (int)entry.levelSlot - 1);
+        if (slot >= 0) apply(slot, (CellState)entry.winner);
+        sequence = entry.sequence;
+        journalEntries++;
+    }
+    return file.size() % sizeof(JournalEntry) == 0;
+}
+
+void HistoryStore::apply(int slot, CellState winner) {
+    HistoryAggregate& aggregate = slots[slot];
+    if (winner == PLAYER_X) {
+        aggregate.xWins++;
+        totals.xWins++;
+    } else if (winner == PLAYER_O) {
+        aggregate.oWins++;
+        totals.oWins++;
+    } else {
+        aggregate.draws++;
+        totals.draws++;
+    }
+}
+
+void HistoryStore::record(int mode, int boardSize, int aiLevel, CellState winner) {
+    int slot = getSlot(mode, boardSize, aiLevel);
+    if (slot < 0) return;
+
+    apply(slot, winner);
+    sequence++;
+    if (!journal.is_open()) return;
+
+    JournalEntry entry;
+    entry.sequence = sequence;
+    entry.mode = (uint8_t)mode;
+    entry.boardSize = (uint8_t)boardSize;
+    entry.levelSlot = (uint8_t)(aiLevel + 1);
+    entry.winner = (uint8_t)winner;
+    entry.reserved = 0;
+    journal.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    journal.flush();
+
+    if (++journalEntries >= HISTORY_CHECKPOINT_INTERVAL) {
+        checkpoint();
+    }
+}
+
+void HistoryStore::merge(int slot, const HistoryAggregate& delta) {
+    if (slot < 0 || slot >= HISTORY_SLOT_COUNT) return;
+
+    slots[slot].xWins += delta.xWins;
+    slots[slot].oWins += delta.oWins;
+    slots[slot].draws += delta.draws;
+    totals.xWins += delta.xWins;
+    totals.oWins += delta.oWins;
+    totals.draws += delta.draws;
+}
+
+bool HistoryStore::writeCheckpoint(const std::string& filename) const {
+    std::string tempName = filename + ".tmp";
+    {
+        std::ofstream file(tempName, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        HistoryHeader header;
+        std::memcpy(header.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC));
+        header.version = HISTORY_VERSION;
+        header.slotCount = HISTORY_SLOT_COUNT;
+        header.reserved = 0;
+        header.sequence = sequence;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(&slots[0]), HISTORY_SLOT_COUNT * sizeof(HistoryAggregate));
+        if (!file) {
+            file.close();
+            std::remove(tempName.c_str());
+            return false;
+        }
+    }
+
+    // Readers see either the old checkpoint or the new one, never a mix
+    if (!replaceFile(tempName, filename)) {
+        std::remove(tempName.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool HistoryStore::checkpoint() {
+    if (checkpointFile.empty() || !writeCheckpoint(checkpointFile)) {
+        return false;
+    }
+
+    // Everything up to 'sequence' is in the checkpoint now
+    journal.close();
+    journal.clear();
+    journal.open(checkpointFile + ".journal", std::ios::binary | std::ios::trunc);
+    journalEntries = 0;
+    return journal.is_open();
+}
+
+void HistoryStore::clear() {
+    for (auto& slot : slots) {
+        slot = HistoryAggregate();
+    }
+    totals = HistoryAggregate();
+    journalEntries = 0;
+    if (isOpen()) {
+        checkpoint();
+    }
+}
+
+HistoryAggregate HistoryStore::getAggregate(int mode, int boardSize, int aiLevel) const {
+    int slot = getSlot(mode, boardSize, aiLevel);
+    return (slot < 0) ? HistoryAggregate() : slots[slot];
+}
+
+HistoryAggregate HistoryStore::getSlotAggregate(int slot) const {
+    return (slot < 0 || slot >= HISTORY_SLOT_COUNT) ? HistoryAggregate() : slots[slot];
+}
+
+HistoryAggregate HistoryStore::getTotals() const {
+    return totals;
+}
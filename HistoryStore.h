@@ -0,0 +1,85 @@
+#ifndef HISTORYSTORE_H
+#define HISTORYSTORE_H
+
+#include "Board.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Default history written by the game
+const char* const HISTORY_FILE = "history.bin";
+
+// History store settings
+const int HISTORY_MAX_MODES = 8;                 // Game modes that can be told apart
+const int HISTORY_MIN_BOARD_SIZE = 3;
+const int HISTORY_MAX_BOARD_SIZE = 6;
+const int HISTORY_MAX_LEVELS = 8;                // AI levels + 1 (slot 0 = no AI)
+const int HISTORY_CHECKPOINT_INTERVAL = 1024;    // Journal entries between checkpoints
+const int HISTORY_SLOT_COUNT = HISTORY_MAX_MODES * (HISTORY_MAX_BOARD_SIZE - HISTORY_MIN_BOARD_SIZE + 1) *
+                               HISTORY_MAX_LEVELS;
+
+// Results of every game played with one (mode, board size, AI level)
+struct HistoryAggregate {
+    uint64_t xWins;
+    uint64_t oWins;
+    uint64_t draws;
+
+    HistoryAggregate() : xWins(0), oWins(0), draws(0) {}
+
+    uint64_t getTotalGames() const {
+        return xWins + oWins + draws;
+    }
+};
+
+// Game results aggregated per (mode, board size, AI level). Aggregates
+// live in a table indexed directly by key, so recording a game and every
+// query are O(1) however long the history grows.
+//
+// On disk a checkpoint holds the whole table and a journal holds the games
+// recorded since. Each game appends one fixed-size journal entry; every
+// HISTORY_CHECKPOINT_INTERVAL games the table is written to a temporary
+// file and renamed over the checkpoint, then the journal is emptied.
+// Journal entries carry sequence numbers, so entries already folded into a
+// checkpoint are skipped if a crash left them behind.
+class HistoryStore {
+public:
+    HistoryStore();
+
+    // Load checkpoint and journal and keep them updated (filename + ".journal")
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const;
+
+    // Table index of a key in [0, HISTORY_SLOT_COUNT), or -1 if out of range
+    static int getSlot(int mode, int boardSize, int aiLevel);
+
+    // aiLevel is -1 when no AI took part; winner is EMPTY for a draw
+    void record(int mode, int boardSize, int aiLevel, CellState winner);
+    // Add results counted elsewhere (not journaled; persisted by the next checkpoint)
+    void merge(int slot, const HistoryAggregate& delta);
+
+    // Write the table as a new checkpoint and empty the journal
+    bool checkpoint();
+    // Write the table to another file (same format, no journal)
+    bool writeCheckpoint(const std::string& filename) const;
+    void clear();
+
+    HistoryAggregate getAggregate(int mode, int boardSize, int aiLevel) const;
+    HistoryAggregate getSlotAggregate(int slot) const;
+    HistoryAggregate getTotals() const;
+
+private:
+    std::vector<HistoryAggregate> slots;
+    HistoryAggregate totals;
+    std::string checkpointFile;
+    std::ofstream journal;
+    uint64_t sequence;          // Sequence number of the last recorded game
+    int journalEntries;
+
+    bool loadCheckpoint();
+    bool replayJournal(uint64_t checkpointSequence);  // False if the last entry is torn
+    void apply(int slot, CellState winner);
+};
+
+#endif
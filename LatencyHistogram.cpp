@@ -0,0 +1,248 @@
+#include "LatencyHistogram.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    const char LATENCY_MAGIC[4] = {'T', 'T', 'T', 'M'};
+    const uint32_t LATENCY_VERSION = 1;
+    const int LATENCY_SIZE_COUNT = LATENCY_MAX_BOARD_SIZE - LATENCY_MIN_BOARD_SIZE + 1;
+    const uint64_t LATENCY_MAX_VALUE = ((uint64_t)1 << LATENCY_MAX_VALUE_BITS) - 1;
+
+    struct LatencyHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t levels;
+        uint32_t sizes;
+        uint32_t buckets;
+        uint32_t reserved;
+    };
+
+    // Each histogram is stored as its max value followed by its bucket counts
+    const size_t LATENCY_HISTOGRAM_BYTES = (1 + LATENCY_BUCKET_COUNT) * sizeof(uint64_t);
+
+    static_assert(sizeof(LatencyHeader) == 24, "latency header layout");
+
+    int getHighestBit(uint64_t value) {
+        int bit = 0;
+        while (value >>= 1) bit++;
+        return bit;
+    }
+
+    void formatMicroseconds(std::ostringstream& out, uint64_t valueUs) {
+        if (valueUs < 1000) {
+            out << valueUs << "us";
+        } else if (valueUs < 100000) {
+            out << (double)(valueUs / 100) / 10.0 << "ms";
+        } else {
+            out << valueUs / 1000 << "ms";
+        }
+    }
+}
+
+LatencyHistogram::LatencyHistogram() {
+    clear();
+}
+
+int LatencyHistogram::getBucketIndex(uint64_t valueUs) {
+    if (valueUs > LATENCY_MAX_VALUE) valueUs = LATENCY_MAX_VALUE;
+    if (valueUs < 2 * LATENCY_HALF_SUB_BUCKETS) return (int)valueUs;
+
+    // Keep the top LATENCY_SUB_BUCKET_BITS bits: the shift picks the power
+    // of two, the remaining bits the linear bucket within it
+    int shift = getHighestBit(valueUs) - (LATENCY_SUB_BUCKET_BITS - 1);
+    int subBucket = (int)(valueUs >> shift) - LATENCY_HALF_SUB_BUCKETS;
+    return 2 * LATENCY_HALF_SUB_BUCKETS + (shift - 1) * LATENCY_HALF_SUB_BUCKETS + subBucket;
+}
+
+uint64_t LatencyHistogram::getBucketUpperBound(int index) {
+    if (index < 2 * LATENCY_HALF_SUB_BUCKETS) return (uint64_t)index;
+
+    int shift = (index - 2 * LATENCY_HALF_SUB_BUCKETS) / LATENCY_HALF_SUB_BUCKETS + 1;
+    uint64_t subBucket = (uint64_t)((index - 2 * LATENCY_HALF_SUB_BUCKETS) % LATENCY_HALF_SUB_BUCKETS +
+                                    LATENCY_HALF_SUB_BUCKETS);
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t valueUs) {
+    counts[getBucketIndex(valueUs)].fetch_add(1, std::memory_order_relaxed);
+    totalCount.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t currentMax = maxValue.load(std::memory_order_relaxed);
+    while (valueUs > currentMax && !maxValue.compare_exchange_weak(currentMax, valueUs, std::memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::clear() {
+    for (auto& count : counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    totalCount.store(0, std::memory_order_relaxed);
+    maxValue.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getCount() const {
+    return totalCount.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMax() const {
+    return maxValue.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getPercentile(double percentile) const {
+    uint64_t total = getCount();
+    if (total == 0) return 0;
+
+    uint64_t target = (uint64_t)(percentile / 100.0 * (double)total + 0.5);
+    if (target < 1) target = 1;
+
+    uint64_t seen = 0;
+    for (int index = 0; index < LATENCY_BUCKET_COUNT; index++) {
+        seen += counts[index].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            // A bucket bound can overshoot the largest value actually seen
+            uint64_t bound = getBucketUpperBound(index);
+            return (bound < getMax()) ? bound : getMax();
+        }
+    }
+    return getMax();
+}
+
+std::string LatencyHistogram::getSummary() const {
+    std::ostringstream out;
+    out << "p50 ";
+    formatMicroseconds(out, getPercentile(50.0));
+    out << "  p90 ";
+    formatMicroseconds(out, getPercentile(90.0));
+    out << "  p99 ";
+    formatMicroseconds(out, getPercentile(99.0));
+    out << "  max ";
+    formatMicroseconds(out, getMax());
+    return out.str();
+}
+
+uint64_t LatencyHistogram::getBucket(int index) const {
+    return counts[index].load(std::memory_order_relaxed);
+}
+
+void LatencyHistogram::addToBucket(int index, uint64_t count, uint64_t maxValueUs) {
+    if (index < 0 || index >= LATENCY_BUCKET_COUNT || count == 0) return;
+
+    counts[index].fetch_add(count, std::memory_order_relaxed);
+    totalCount.fetch_add(count, std::memory_order_relaxed);
+
+    uint64_t currentMax = maxValue.load(std::memory_order_relaxed);
+    while (maxValueUs > currentMax &&
+           !maxValue.compare_exchange_weak(currentMax, maxValueUs, std::memory_order_relaxed)) {}
+}
+
+MoveLatencyTable::MoveLatencyTable() {}
+
+LatencyHistogram* MoveLatencyTable::findHistogram(int aiLevel, int boardSize) {
+    if (aiLevel < 0 || aiLevel >= LATENCY_MAX_LEVELS || boardSize < LATENCY_MIN_BOARD_SIZE ||
+        boardSize > LATENCY_MAX_BOARD_SIZE) {
+        return nullptr;
+    }
+    return &histograms[aiLevel][boardSize - LATENCY_MIN_BOARD_SIZE];
+}
+
+const LatencyHistogram* MoveLatencyTable::getHistogram(int aiLevel, int boardSize) const {
+    return const_cast<MoveLatencyTable*>(this)->findHistogram(aiLevel, boardSize);
+}
+
+void MoveLatencyTable::record(int aiLevel, int boardSize, uint64_t valueUs) {
+    LatencyHistogram* histogram = findHistogram(aiLevel, boardSize);
+    if (histogram) histogram->record(valueUs);
+}
+
+void MoveLatencyTable::clear() {
+    for (auto& level : histograms) {
+        for (auto& histogram : level) histogram.clear();
+    }
+}
+
+std::string MoveLatencyTable::getSummary(int aiLevel, int boardSize) const {
+    const LatencyHistogram* histogram = getHistogram(aiLevel, boardSize);
+    if (!histogram || histogram->getCount() == 0) return "";
+
+    std::ostringstream out;
+    out << histogram->getSummary() << "  (" << histogram->getCount() << " moves)";
+    return out.str();
+}
+
+// Loaded counts are added to what is already recorded
+bool MoveLatencyTable::load(const std::string& filename) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        return false;
+    }
+
+    LatencyHeader header;
+    size_t expectedSize = sizeof(header) + LATENCY_MAX_LEVELS * LATENCY_SIZE_COUNT * LATENCY_HISTOGRAM_BYTES;
+    if (file.size() < expectedSize) {
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, LATENCY_MAGIC, sizeof(LATENCY_MAGIC)) != 0 || header.version != LATENCY_VERSION ||
+        header.levels != (uint32_t)LATENCY_MAX_LEVELS || header.sizes != (uint32_t)LATENCY_SIZE_COUNT ||
+        header.buckets != (uint32_t)LATENCY_BUCKET_COUNT) {
+        return false;
+    }
+
+    const unsigned char* data = file.data() + sizeof(header);
+    for (auto& level : histograms) {
+        for (auto& histogram : level) {
+            uint64_t values[1 + LATENCY_BUCKET_COUNT];
+            std::memcpy(values, data, LATENCY_HISTOGRAM_BYTES);
+            data += LATENCY_HISTOGRAM_BYTES;
+
+            for (int index = 0; index < LATENCY_BUCKET_COUNT; index++) {
+                histogram.addToBucket(index, values[1 + index], values[0]);
+            }
+        }
+    }
+    return true;
+}
+
+bool MoveLatencyTable::save(const std::string& filename) const {
+    std::string tempName = filename + ".tmp";
+    {
+        std::ofstream file(tempName, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        LatencyHeader header;
+        std::memcpy(header.magic, LATENCY_MAGIC, sizeof(LATENCY_MAGIC));
+        header.version = LATENCY_VERSION;
+        header.levels = LATENCY_MAX_LEVELS;
+        header.sizes = LATENCY_SIZE_COUNT;
+        header.buckets = LATENCY_BUCKET_COUNT;
+        header.reserved = 0;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (const auto& level : histograms) {
+            for (const auto& histogram : level) {
+                uint64_t values[1 + LATENCY_BUCKET_COUNT];
+                values[0] = histogram.getMax();
+                for (int index = 0; index < LATENCY_BUCKET_COUNT; index++) {
+                    values[1 + index] = histogram.getBucket(index);
+                }
+                file.write(reinterpret_cast<const char*>(values), LATENCY_HISTOGRAM_BYTES);
+            }
+        }
+
+        if (!file) {
+            file.close();
+            std::remove(tempName.c_str());
+            return false;
+        }
+    }
+
+    if (!replaceFile(tempName, filename)) {
+        std::remove(tempName.c_str());
+        return false;
+    }
+    return true;
+}
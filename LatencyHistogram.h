@@ -0,0 +1,79 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Default latency file written by the game
+const char* const LATENCY_FILE = "latency.bin";
+
+// Histogram settings
+const int LATENCY_SUB_BUCKET_BITS = 5;           // 16 linear buckets per power of two: within 1/16 (about 6%)
+const int LATENCY_MAX_VALUE_BITS = 32;           // Values are clamped to 2^32 - 1 us (over an hour)
+const int LATENCY_HALF_SUB_BUCKETS = 1 << (LATENCY_SUB_BUCKET_BITS - 1);
+const int LATENCY_BUCKET_COUNT = (LATENCY_MAX_VALUE_BITS - LATENCY_SUB_BUCKET_BITS + 2) * LATENCY_HALF_SUB_BUCKETS;
+
+// Move latency table settings
+const int LATENCY_MAX_LEVELS = 4;                // AILevel values
+const int LATENCY_MIN_BOARD_SIZE = 3;
+const int LATENCY_MAX_BOARD_SIZE = 6;
+
+// HDR-style histogram of durations in microseconds. Values below 32 get a
+// bucket each; above that every power of two is split into 16 linear
+// buckets, so a few hundred counters cover microseconds to hours with at
+// most 1/16 (about 6%) relative error. Counters are atomic: any number of threads may
+// record at once without locks.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(uint64_t valueUs);
+    void clear();
+
+    uint64_t getCount() const;
+    uint64_t getMax() const;
+    // Smallest bucket bound that at least 'percentile' percent of the values fall under
+    uint64_t getPercentile(double percentile) const;
+    // "p50 1.2ms  p90 3.4ms  p99 12ms  max 15ms"
+    std::string getSummary() const;
+
+    uint64_t getBucket(int index) const;
+    void addToBucket(int index, uint64_t count, uint64_t maxValueUs);
+
+    static int getBucketIndex(uint64_t valueUs);
+    static uint64_t getBucketUpperBound(int index);
+
+private:
+    std::atomic<uint64_t> counts[LATENCY_BUCKET_COUNT];
+    std::atomic<uint64_t> totalCount;
+    std::atomic<uint64_t> maxValue;
+
+    LatencyHistogram(const LatencyHistogram&);
+    LatencyHistogram& operator=(const LatencyHistogram&);
+};
+
+// Move latency histograms per (AI level, board size), saved to disk as one
+// fixed-layout file written through a temporary file and a rename
+class MoveLatencyTable {
+public:
+    MoveLatencyTable();
+
+    void record(int aiLevel, int boardSize, uint64_t valueUs);
+    void clear();
+
+    // nullptr if the key is out of range
+    const LatencyHistogram* getHistogram(int aiLevel, int boardSize) const;
+    // "p50 1.2ms  p90 3.4ms  p99 12ms  max 15ms  (240 moves)", or "" if empty
+    std::string getSummary(int aiLevel, int boardSize) const;
+
+    bool load(const std::string& filename);
+    bool save(const std::string& filename) const;
+
+private:
+    LatencyHistogram histograms[LATENCY_MAX_LEVELS][LATENCY_MAX_BOARD_SIZE - LATENCY_MIN_BOARD_SIZE + 1];
+
+    LatencyHistogram* findHistogram(int aiLevel, int boardSize);
+};
+
+#endif
@@ -0,0 +1,120 @@
+#include "MappedFile.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile() : mappedData(nullptr), mappedSize(0), fileHandle(nullptr), mappingHandle(nullptr) {}
+#else
+MappedFile::MappedFile() : mappedData(nullptr), mappedSize(0), fileDescriptor(-1) {}
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+    
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    
+    fileHandle = file;
+    mappingHandle = mapping;
+    mappedData = static_cast<const unsigned char*>(view);
+    mappedSize = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    
+    void* view = mmap(nullptr, (size_t)fileInfo.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+    
+    fileDescriptor = fd;
+    mappedData = static_cast<const unsigned char*>(view);
+    mappedSize = (size_t)fileInfo.st_size;
+#endif
+    
+    return true;
+}
+
+void MappedFile::close() {
+    if (!mappedData) return;
+    
+#ifdef _WIN32
+    UnmapViewOfFile(mappedData);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(mappedData), mappedSize);
+    ::close(fileDescriptor);
+    fileDescriptor = -1;
+#endif
+    
+    mappedData = nullptr;
+    mappedSize = 0;
+}
+
+bool MappedFile::isOpen() const {
+    return mappedData != nullptr;
+}
+
+const unsigned char* MappedFile::data() const {
+    return mappedData;
+}
+
+size_t MappedFile::size() const {
+    return mappedSize;
+}
+
+bool replaceFile(const std::string& source, const std::string& target) {
+#ifdef _WIN32
+    // rename() refuses an existing target on Windows
+    return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(source.c_str(), target.c_str()) == 0;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file (Win32 or POSIX)
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    
+    bool open(const std::string& filename);
+    void close();
+    
+    bool isOpen() const;
+    const unsigned char* data() const;
+    size_t size() const;
+    
+private:
+    const unsigned char* mappedData;
+    size_t mappedSize;
+    
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+    
+    // Mappings own OS handles and must not be copied
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+};
+
+// Move source over target in one step, replacing any existing target, so
+// readers see either the old file or the new one (Win32 or POSIX)
+bool replaceFile(const std::string& source, const std::string& target);
+
+#endif
\ No newline at end of file
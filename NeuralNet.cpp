@@ -0,0 +1,280 @@
+#include "NeuralNet.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NEURAL_USE_SSE
+#endif
+
+namespace {
+    const char NET_MAGIC[4] = {'T', 'T', 'T', 'N'};
+    const uint32_t NET_VERSION = 1;
+    
+    struct NetHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t boardSize;
+        uint32_t winCondition;
+        uint32_t hiddenSize;
+        uint32_t reserved;
+    };
+    
+    // acc += row
+    void addRow(float* acc, const float* row, int n) {
+        int i = 0;
+#if defined(__AVX2__)
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i), _mm256_loadu_ps(row + i)));
+        }
+#elif defined(NEURAL_USE_SSE)
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_loadu_ps(row + i)));
+        }
+#endif
+        for (; i < n; i++) {
+            acc[i] += row[i];
+        }
+    }
+    
+    void relu(float* values, int n) {
+        int i = 0;
+#if defined(__AVX2__)
+        const __m256 zero = _mm256_setzero_ps();
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(values + i, _mm256_max_ps(_mm256_loadu_ps(values + i), zero));
+        }
+#elif defined(NEURAL_USE_SSE)
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_ps(values + i, _mm_max_ps(_mm_loadu_ps(values + i), zero));
+        }
+#endif
+        for (; i < n; i++) {
+            if (values[i] < 0.0f) values[i] = 0.0f;
+        }
+    }
+    
+    float dot(const float* a, const float* b, int n) {
+        float sum = 0.0f;
+        int i = 0;
+#if defined(__AVX2__)
+        __m256 acc = _mm256_setzero_ps();
+        for (; i + 8 <= n; i += 8) {
+#if defined(__FMA__)
+            acc = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc);
+#else
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+#endif
+        }
+        // Horizontal sum of the 8 lanes
+        __m128 low = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        low = _mm_add_ps(low, _mm_movehl_ps(low, low));
+        low = _mm_add_ss(low, _mm_shuffle_ps(low, low, 1));
+        sum = _mm_cvtss_f32(low);
+#elif defined(NEURAL_USE_SSE)
+        __m128 acc = _mm_setzero_ps();
+        for (; i + 4 <= n; i += 4) {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        }
+        acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+        acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+        sum = _mm_cvtss_f32(acc);
+#endif
+        for (; i < n; i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+}
+
+void NeuralWeights::initialize(int size, int winCond, int hidden, unsigned int seed) {
+    boardSize = size;
+    winCondition = winCond;
+    hiddenSize = hidden;
+    
+    int inputs = getInputCount();
+    int cells = getCellCount();
+    std::mt19937 gen(seed);
+    
+    // Uniform Xavier initialisation
+    std::uniform_real_distribution<float> inputDist(-std::sqrt(6.0f / (inputs + hidden)), std::sqrt(6.0f / (inputs + hidden)));
+    std::uniform_real_distribution<float> outputDist(-std::sqrt(6.0f / (hidden + cells)), std::sqrt(6.0f / (hidden + cells)));
+    
+    inputWeights.resize(inputs * hidden);
+    for (auto& w : inputWeights) w = inputDist(gen);
+    hiddenBias.assign(hidden, 0.0f);
+    policyWeights.resize(cells * hidden);
+    for (auto& w : policyWeights) w = outputDist(gen);
+    policyBias.assign(cells, 0.0f);
+    valueWeights.resize(hidden);
+    for (auto& w : valueWeights) w = outputDist(gen);
+    valueBias = 0.0f;
+}
+
+int NeuralWeights::getInputCount() const {
+    return 2 * boardSize * boardSize;
+}
+
+int NeuralWeights::getCellCount() const {
+    return boardSize * boardSize;
+}
+
+NeuralNet::NeuralNet() : loaded(false), attemptedSize(0), attemptedWinCondition(0) {}
+
+bool NeuralNet::load(int boardSize, int winCondition) {
+    if (boardSize == attemptedSize && winCondition == attemptedWinCondition) {
+        return loaded; // Already loaded, or already known to be missing
+    }
+    
+    attemptedSize = boardSize;
+    attemptedWinCondition = winCondition;
+    loaded = loadWeights(getFileName(boardSize, winCondition), weights) &&
+             weights.boardSize == boardSize && weights.winCondition == winCondition;
+    
+    if (loaded) {
+        hidden.resize(weights.hiddenSize);
+    }
+    return loaded;
+}
+
+bool NeuralNet::isLoaded() const {
+    return loaded;
+}
+
+float NeuralNet::evaluate(const Board& board, CellState toMove, std::vector<float>& policy) {
+    int hiddenSize = weights.hiddenSize;
+    int cells = weights.getCellCount();
+    
+    // Inputs are one-hot, so the first layer is a sum of weight rows
+    encodeInputs(board, toMove, activeInputs);
+    std::memcpy(hidden.data(), weights.hiddenBias.data(), hiddenSize * sizeof(float));
+    for (int input : activeInputs) {
+        addRow(hidden.data(), &weights.inputWeights[input * hiddenSize], hiddenSize);
+    }
+    relu(hidden.data(), hiddenSize);
+    
+    policy.resize(cells);
+    for (int cell = 0; cell < cells; cell++) {
+        policy[cell] = weights.policyBias[cell] + dot(&weights.policyWeights[cell * hiddenSize], hidden.data(), hiddenSize);
+    }
+    
+    return std::tanh(weights.valueBias + dot(weights.valueWeights.data(), hidden.data(), hiddenSize));
+}
+
+std::pair<int, int> NeuralNet::getBestMove(const Board& board, CellState toMove) {
+    if (!loaded || board.getSize() != weights.boardSize) {
+        return {-1, -1};
+    }
+    
+    std::vector<float> policy;
+    evaluate(board, toMove, policy);
+    
+    int boardSize = board.getSize();
+    int bestCell = -1;
+    for (int cell = 0; cell < (int)policy.size(); cell++) {
+        if (board.getCell(cell / boardSize, cell % boardSize) != EMPTY) continue;
+        if (bestCell == -1 || policy[cell] > policy[bestCell]) {
+            bestCell = cell;
+        }
+    }
+    
+    if (bestCell == -1) {
+        return {-1, -1};
+    }
+    return {bestCell / boardSize, bestCell % boardSize};
+}
+
+bool NeuralNet::loadWeights(const std::string& filename, NeuralWeights& result) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    NetHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, NET_MAGIC, sizeof(NET_MAGIC)) != 0 || header.version != NET_VERSION ||
+        header.boardSize < 3 || header.boardSize > 16 || header.hiddenSize == 0 || header.hiddenSize > 4096) {
+        return false;
+    }
+    
+    NeuralWeights loadedWeights;
+    loadedWeights.boardSize = (int)header.boardSize;
+    loadedWeights.winCondition = (int)header.winCondition;
+    loadedWeights.hiddenSize = (int)header.hiddenSize;
+    
+    int inputs = loadedWeights.getInputCount();
+    int cells = loadedWeights.getCellCount();
+    int hiddenSize = loadedWeights.hiddenSize;
+    loadedWeights.inputWeights.resize(inputs * hiddenSize);
+    loadedWeights.hiddenBias.resize(hiddenSize);
+    loadedWeights.policyWeights.resize(cells * hiddenSize);
+    loadedWeights.policyBias.resize(cells);
+    loadedWeights.valueWeights.resize(hiddenSize);
+    
+    std::vector<float>* arrays[] = {&loadedWeights.inputWeights, &loadedWeights.hiddenBias, &loadedWeights.policyWeights,
+                                    &loadedWeights.policyBias, &loadedWeights.valueWeights};
+    for (auto* values : arrays) {
+        file.read(reinterpret_cast<char*>(values->data()), values->size() * sizeof(float));
+    }
+    file.read(reinterpret_cast<char*>(&loadedWeights.valueBias), sizeof(float));
+    
+    if (!file) {
+        return false;
+    }
+    
+    result = loadedWeights;
+    return true;
+}
+
+bool NeuralNet::saveWeights(const std::string& filename, const NeuralWeights& source) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    NetHeader header;
+    std::memcpy(header.magic, NET_MAGIC, sizeof(NET_MAGIC));
+    header.version = NET_VERSION;
+    header.boardSize = (uint32_t)source.boardSize;
+    header.winCondition = (uint32_t)source.winCondition;
+    header.hiddenSize = (uint32_t)source.hiddenSize;
+    header.reserved = 0;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    
+    const std::vector<float>* arrays[] = {&source.inputWeights, &source.hiddenBias, &source.policyWeights,
+                                          &source.policyBias, &source.valueWeights};
+    for (const auto* values : arrays) {
+        file.write(reinterpret_cast<const char*>(values->data()), values->size() * sizeof(float));
+    }
+    file.write(reinterpret_cast<const char*>(&source.valueBias), sizeof(float));
+    
+    return (bool)file;
+}
+
+std::string NeuralNet::getFileName(int boardSize, int winCondition) {
+    std::stringstream ss;
+    ss << "nn_" << boardSize << "x" << boardSize << "_" << winCondition << ".bin";
+    return ss.str();
+}
+
+void NeuralNet::encodeInputs(const Board& board, CellState toMove, std::vector<int>& inputs) {
+    int boardSize = board.getSize();
+    int cells = boardSize * boardSize;
+    inputs.clear();
+    
+    for (int cell = 0; cell < cells; cell++) {
+        CellState state = board.getCell(cell / boardSize, cell % boardSize);
+        if (state == toMove) {
+            inputs.push_back(cell);
+        } else if (state != EMPTY) {
+            inputs.push_back(cells + cell);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef NEURALNET_H
+#define NEURALNET_H
+
+#include "Board.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+// Network settings
+const int NEURAL_HIDDEN_SIZE = 64;  // Multiple of 8 so the SIMD kernels need no tail loop
+
+// Weights of a two-layer MLP over the board planes:
+//   inputs  = 2 planes of N*N cells (side to move, opponent), one-hot
+//   hidden  = ReLU(W1 * inputs + b1)
+//   policy  = Wp * hidden + bp           (one logit per cell)
+//   value   = tanh(Wv . hidden + bv)     (expected result for the side to move)
+struct NeuralWeights {
+    int boardSize;
+    int winCondition;
+    int hiddenSize;
+    std::vector<float> inputWeights;   // [2 * N * N][hidden], one row per input
+    std::vector<float> hiddenBias;     // [hidden]
+    std::vector<float> policyWeights;  // [N * N][hidden]
+    std::vector<float> policyBias;     // [N * N]
+    std::vector<float> valueWeights;   // [hidden]
+    float valueBias;
+    
+    NeuralWeights() : boardSize(0), winCondition(0), hiddenSize(0), valueBias(0.0f) {}
+    
+    void initialize(int size, int winCond, int hidden, unsigned int seed);
+    int getInputCount() const;
+    int getCellCount() const;
+};
+
+// Inference for the NEURAL AI level. Weights are loaded from
+// nn_<N>x<N>_<win>.bin; the layers run on AVX2/SSE kernels when the
+// compiler targets them and on plain loops otherwise.
+class NeuralNet {
+public:
+    NeuralNet();
+    
+    // Load the weights for this configuration (no-op if already loaded)
+    bool load(int boardSize, int winCondition);
+    bool isLoaded() const;
+    
+    // Policy logits for every cell and the value estimate, for the side to move
+    float evaluate(const Board& board, CellState toMove, std::vector<float>& policy);
+    
+    // Highest-policy empty cell, or {-1, -1}
+    std::pair<int, int> getBestMove(const Board& board, CellState toMove);
+    
+    static bool loadWeights(const std::string& filename, NeuralWeights& weights);
+    static bool saveWeights(const std::string& filename, const NeuralWeights& weights);
+    static std::string getFileName(int boardSize, int winCondition);
+    
+    // Encode a position as active input indices (side to move first)
+    static void encodeInputs(const Board& board, CellState toMove, std::vector<int>& activeInputs);
+    
+private:
+    NeuralWeights weights;
+    bool loaded;
+    int attemptedSize;
+    int attemptedWinCondition;
+    std::vector<float> hidden;
+    std::vector<int> activeInputs;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <cstddef>
+#include <vector>
+
+// Recycles objects instead of freeing them. Objects are allocated in
+// chunks that are never moved or released until the pool is destroyed, so
+// pointers stay valid (a released object may be handed out again) and the
+// steady state does no heap allocation. acquire() returns a recycled object
+// as it was released; callers reset the state they use. Not thread-safe.
+template <typename T>
+class ObjectPool {
+public:
+    explicit ObjectPool(size_t chunkSize = 256) : chunkSize(chunkSize > 0 ? chunkSize : 1), liveCount(0) {}
+
+    ~ObjectPool() {
+        for (T* chunk : chunks) {
+            delete[] chunk;
+        }
+    }
+
+    T* acquire() {
+        if (freeList.empty()) {
+            T* chunk = new T[chunkSize];
+            chunks.push_back(chunk);
+            freeList.reserve(chunks.size() * chunkSize);
+            for (size_t i = chunkSize; i > 0; i--) {
+                freeList.push_back(&chunk[i - 1]);
+            }
+        }
+
+        T* object = freeList.back();
+        freeList.pop_back();
+        liveCount++;
+        return object;
+    }
+
+    void release(T* object) {
+        freeList.push_back(object);
+        liveCount--;
+    }
+
+    size_t getLiveCount() const {
+        return liveCount;
+    }
+
+    size_t getCapacity() const {
+        return chunks.size() * chunkSize;
+    }
+
+private:
+    ObjectPool(const ObjectPool&);
+    ObjectPool& operator=(const ObjectPool&);
+
+    size_t chunkSize;
+    size_t liveCount;
+    std::vector<T*> chunks;
+    std::vector<T*> freeList;
+};
+
+#endif
@@ -0,0 +1,242 @@
+#include "OpeningBook.h"
+#include "PositionCache.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    const char BOOK_MAGIC[4] = {'T', 'T', 'T', 'B'};
+    const uint32_t BOOK_VERSION = 1;
+    
+    struct BookHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t boardSize;
+        uint32_t winCondition;
+        uint32_t maxPly;
+        uint32_t entryCount;
+        uint32_t moveCount;
+        uint32_t reserved;
+    };
+    
+    static_assert(sizeof(BookHeader) == 32, "book header layout");
+    static_assert(sizeof(BookEntry) == 16, "book entry layout");
+    static_assert(sizeof(BookMove) == 4, "book move layout");
+}
+
+OpeningBook::OpeningBook() : entries(nullptr), moves(nullptr), entryCount(0), moveCount(0),
+                             boardSize(0), winCondition(0), maxPly(0) {}
+
+bool OpeningBook::open(int size, int winCond) {
+    if (size == boardSize && winCond == winCondition) {
+        return isOpen(); // Already open, or already known to be missing
+    }
+    
+    close();
+    boardSize = size;
+    winCondition = winCond;
+    
+    if (!file.open(getFileName(size, winCond))) {
+        return false;
+    }
+    
+    BookHeader header;
+    if (file.size() < sizeof(header)) {
+        file.close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    
+    size_t expectedSize = sizeof(header) + (size_t)header.entryCount * sizeof(BookEntry) +
+                          (size_t)header.moveCount * sizeof(BookMove);
+    if (std::memcmp(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) != 0 || header.version != BOOK_VERSION ||
+        (int)header.boardSize != size || (int)header.winCondition != winCond || file.size() < expectedSize) {
+        file.close();
+        return false;
+    }
+    
+    entries = reinterpret_cast<const BookEntry*>(file.data() + sizeof(header));
+    moves = reinterpret_cast<const BookMove*>(file.data() + sizeof(header) + header.entryCount * sizeof(BookEntry));
+    entryCount = header.entryCount;
+    moveCount = header.moveCount;
+    maxPly = (int)header.maxPly;
+    return true;
+}
+
+void OpeningBook::close() {
+    file.close();
+    entries = nullptr;
+    moves = nullptr;
+    entryCount = 0;
+    moveCount = 0;
+    boardSize = 0;
+    winCondition = 0;
+    maxPly = 0;
+}
+
+bool OpeningBook::isOpen() const {
+    return file.isOpen();
+}
+
+std::pair<int, int> OpeningBook::getMove(const Board& board, CellState toMove, std::mt19937& gen) {
+    auto bookMoves = getMoves(board, toMove);
+    if (bookMoves.empty()) {
+        return {-1, -1};
+    }
+    
+    int totalWeight = 0;
+    for (const auto& move : bookMoves) {
+        totalWeight += move.second;
+    }
+    
+    std::uniform_int_distribution<> dis(0, std::max(totalWeight - 1, 0));
+    
+    int pick = dis(gen);
+    for (const auto& move : bookMoves) {
+        pick -= move.second;
+        if (pick < 0) return move.first;
+    }
+    return bookMoves.back().first;
+}
+
+std::vector<std::pair<std::pair<int, int>, int>> OpeningBook::getMoves(const Board& board, CellState toMove) const {
+    std::vector<std::pair<std::pair<int, int>, int>> result;
+    if (!isOpen() || board.getSize() != boardSize) {
+        return result;
+    }
+    
+    // Skip the lookup entirely past the end of the book
+    int ply = boardSize * boardSize - (int)board.getEmptyCells().size();
+    if (ply >= maxPly) {
+        return result;
+    }
+    
+    int symmetry = 0;
+    const BookEntry* entry = findEntry(canonicalKey(board, toMove, symmetry));
+    if (!entry || entry->firstMove + entry->moveCount > moveCount) {
+        return result;
+    }
+    
+    // Book moves are stored in the canonical orientation
+    int inverse = inverseSymmetry(symmetry);
+    for (uint32_t i = 0; i < entry->moveCount; i++) {
+        const BookMove& move = moves[entry->firstMove + i];
+        int cell = transformCell(move.cell, boardSize, inverse);
+        int row = cell / boardSize;
+        int col = cell % boardSize;
+        if (board.getCell(row, col) == EMPTY && move.weight > 0) {
+            result.push_back({{row, col}, move.weight});
+        }
+    }
+    
+    return result;
+}
+
+int OpeningBook::getMaxPly() const {
+    return maxPly;
+}
+
+bool OpeningBook::write(const std::string& filename, int size, int winCond, int bookPlies,
+                        const std::map<uint64_t, std::vector<BookMove>>& positions) {
+    std::vector<BookEntry> bookEntries;
+    std::vector<BookMove> bookMoves;
+    
+    // std::map iterates in key order, which is the sorted order lookup needs
+    for (const auto& position : positions) {
+        if (position.second.empty()) continue;
+        
+        BookEntry entry;
+        entry.key = position.first;
+        entry.firstMove = (uint32_t)bookMoves.size();
+        entry.moveCount = (uint16_t)position.second.size();
+        entry.reserved = 0;
+        bookEntries.push_back(entry);
+        bookMoves.insert(bookMoves.end(), position.second.begin(), position.second.end());
+    }
+    
+    BookHeader header;
+    std::memcpy(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+    header.version = BOOK_VERSION;
+    header.boardSize = (uint32_t)size;
+    header.winCondition = (uint32_t)winCond;
+    header.maxPly = (uint32_t)bookPlies;
+    header.entryCount = (uint32_t)bookEntries.size();
+    header.moveCount = (uint32_t)bookMoves.size();
+    header.reserved = 0;
+    
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!bookEntries.empty()) {
+        file.write(reinterpret_cast<const char*>(bookEntries.data()), bookEntries.size() * sizeof(BookEntry));
+        file.write(reinterpret_cast<const char*>(bookMoves.data()), bookMoves.size() * sizeof(BookMove));
+    }
+    return (bool)file;
+}
+
+std::string OpeningBook::getFileName(int size, int winCond) {
+    std::stringstream ss;
+    ss << "book_" << size << "x" << size << "_" << winCond << ".bin";
+    return ss.str();
+}
+
+int OpeningBook::transformCell(int cell, int size, int symmetry) {
+    int row = cell / size;
+    int col = cell % size;
+    int last = size - 1;
+    
+    switch (symmetry) {
+        case 1: return col * size + (last - row);           // Rotate 90
+        case 2: return (last - row) * size + (last - col);  // Rotate 180
+        case 3: return (last - col) * size + row;           // Rotate 270
+        case 4: return row * size + (last - col);           // Mirror left-right
+        case 5: return col * size + row;                    // Transpose
+        case 6: return (last - row) * size + col;           // Mirror top-bottom
+        case 7: return (last - col) * size + (last - row);  // Anti-transpose
+        default: return cell;
+    }
+}
+
+int OpeningBook::inverseSymmetry(int symmetry) {
+    // The two quarter turns undo each other; everything else is its own inverse
+    if (symmetry == 1) return 3;
+    if (symmetry == 3) return 1;
+    return symmetry;
+}
+
+uint64_t OpeningBook::canonicalKey(const Board& board, CellState toMove, int& symmetry) {
+    int size = board.getSize();
+    uint64_t bestKey = 0;
+    symmetry = 0;
+    
+    for (int s = 0; s < 8; s++) {
+        Board transformed(size, board.getWinCondition());
+        for (int cell = 0; cell < size * size; cell++) {
+            CellState state = board.getCell(cell / size, cell % size);
+            if (state != EMPTY) {
+                int target = transformCell(cell, size, s);
+                transformed.makeMove(target / size, target % size, state);
+            }
+        }
+        
+        uint64_t key = PositionCache::makeKey(transformed, toMove);
+        if (s == 0 || key < bestKey) {
+            bestKey = key;
+            symmetry = s;
+        }
+    }
+    
+    return bestKey;
+}
+
+const BookEntry* OpeningBook::findEntry(uint64_t key) const {
+    const BookEntry* end = entries + entryCount;
+    const BookEntry* it = std::lower_bound(entries, end, key, [](const BookEntry& entry, uint64_t value) {
+        return entry.key < value;
+    });
+    return (it != end && it->key == key) ? it : nullptr;
+}
\ No newline at end of file
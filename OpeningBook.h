@@ -0,0 +1,71 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include "Board.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A book move, in the canonical orientation of its position
+struct BookMove {
+    uint8_t cell;       // Cell index (row * size + col)
+    uint8_t reserved;
+    uint16_t weight;    // Relative probability of playing this move
+};
+
+// Index entry; entries are sorted by key so lookup is a binary search
+struct BookEntry {
+    uint64_t key;
+    uint32_t firstMove; // Index into the move array
+    uint16_t moveCount;
+    uint16_t reserved;
+};
+
+// Opening book for one (boardSize, winCondition). Positions are stored
+// under the smallest key of their 8 symmetric variants, so one entry
+// covers every rotation and reflection. The file is memory-mapped and
+// never parsed.
+class OpeningBook {
+public:
+    OpeningBook();
+    
+    // Map the book for this configuration (no-op if already open)
+    bool open(int boardSize, int winCondition);
+    void close();
+    bool isOpen() const;
+    
+    // Pick a weighted book move for the side to move, or {-1, -1}
+    std::pair<int, int> getMove(const Board& board, CellState toMove, std::mt19937& gen);
+    
+    // Book moves for a position, translated to the board's orientation
+    std::vector<std::pair<std::pair<int, int>, int>> getMoves(const Board& board, CellState toMove) const;
+    
+    int getMaxPly() const;
+    
+    static bool write(const std::string& filename, int boardSize, int winCondition, int maxPly,
+                      const std::map<uint64_t, std::vector<BookMove>>& positions);
+    static std::string getFileName(int boardSize, int winCondition);
+    
+    // Symmetry helpers: 8 transforms of the square (rotations and reflections)
+    static int transformCell(int cell, int boardSize, int symmetry);
+    static int inverseSymmetry(int symmetry);
+    static uint64_t canonicalKey(const Board& board, CellState toMove, int& symmetry);
+    
+private:
+    MappedFile file;
+    const BookEntry* entries;
+    const BookMove* moves;
+    uint32_t entryCount;
+    uint32_t moveCount;
+    int boardSize;
+    int winCondition;
+    int maxPly;
+    
+    const BookEntry* findEntry(uint64_t key) const;
+};
+
+#endif
\ No newline at end of file
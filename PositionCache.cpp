@@ -0,0 +1,229 @@
+#include "PositionCache.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    const char CACHE_MAGIC[4] = {'T', 'T', 'T', 'C'};
+    const uint32_t CACHE_VERSION = 1;
+    const uint64_t SIDE_TO_MOVE_KEY = 0x5BD1E9955BD1E995ULL;
+    
+    struct CacheHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t boardSize;
+        uint32_t winCondition;
+    };
+}
+
+PositionCache::PositionCache()
+    : boardSize(0), winCondition(0), loaded(false), persistent(true), rewriteNeeded(false), fileRecords(0) {}
+
+PositionCache::~PositionCache() {
+    flush();
+}
+
+void PositionCache::configure(int size, int winCond) {
+    if (size == boardSize && winCond == winCondition) return;
+    
+    flush();
+    entries.clear();
+    pending.clear();
+    boardSize = size;
+    winCondition = winCond;
+    loaded = false;
+    rewriteNeeded = false;
+    fileRecords = 0;
+}
+
+bool PositionCache::lookup(uint64_t key, int depth, int& score, int& bestMove) {
+    if (!loaded) load();
+    
+    auto it = entries.find(key);
+    if (it == entries.end() || it->second.depth < depth) {
+        return false;
+    }
+    
+    score = it->second.score;
+    bestMove = (it->second.bestMove == CACHE_NO_MOVE) ? -1 : it->second.bestMove;
+    return true;
+}
+
+void PositionCache::store(uint64_t key, int depth, int score, int bestMove) {
+    if (!loaded) load();
+    
+    CacheRecord& record = entries[key];
+    if (record.key == key && record.depth > depth) {
+        return; // Keep the deeper result
+    }
+    
+    record.key = key;
+    record.score = (int16_t)score;
+    record.depth = (uint8_t)depth;
+    record.bestMove = (bestMove < 0) ? CACHE_NO_MOVE : (uint8_t)bestMove;
+    record.reserved = 0;
+    
+    if (persistent && depth >= POSITION_CACHE_MIN_SAVED_DEPTH) {
+        pending.push_back(record);
+    }
+}
+
+bool PositionCache::flush() {
+    if (!persistent || pending.empty() || boardSize == 0) return true;
+    if (!loaded) load();
+    
+    // Rewrite instead of appending once the file is mostly superseded records,
+    // or when appending would land after a torn record
+    size_t totalRecords = fileRecords + pending.size();
+    if (rewriteNeeded || fileRecords == 0 || totalRecords > POSITION_CACHE_MAX_RECORDS || totalRecords > entries.size() * 2) {
+        return compact();
+    }
+    
+    std::ofstream file(getFileName(boardSize, winCondition), std::ios::binary | std::ios::app);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    file.write(reinterpret_cast<const char*>(pending.data()), pending.size() * sizeof(CacheRecord));
+    if (!file) {
+        return false;
+    }
+    
+    fileRecords += pending.size();
+    pending.clear();
+    return true;
+}
+
+bool PositionCache::compact() {
+    if (!persistent || boardSize == 0) return true;
+    if (!loaded) load();
+    
+    std::vector<CacheRecord> records;
+    records.reserve(entries.size());
+    for (const auto& entry : entries) {
+        if (entry.second.depth >= POSITION_CACHE_MIN_SAVED_DEPTH) {
+            records.push_back(entry.second);
+        }
+    }
+    
+    // Over the cap, keep the deepest (most expensive) results
+    if (records.size() > POSITION_CACHE_MAX_RECORDS) {
+        std::nth_element(records.begin(), records.begin() + POSITION_CACHE_MAX_RECORDS, records.end(),
+                         [](const CacheRecord& a, const CacheRecord& b) { return a.depth > b.depth; });
+        records.resize(POSITION_CACHE_MAX_RECORDS);
+    }
+    
+    // Write a new file and swap it in, so a crash never leaves a torn cache
+    std::string filename = getFileName(boardSize, winCondition);
+    std::string tempName = filename + ".tmp";
+    if (!writeFile(tempName, records)) {
+        std::remove(tempName.c_str());
+        return false;
+    }
+    
+    if (!replaceFile(tempName, filename)) {
+        std::remove(tempName.c_str());
+        return false;
+    }
+    
+    fileRecords = records.size();
+    rewriteNeeded = false;
+    pending.clear();
+    return true;
+}
+
+// Empties the in-memory set only. Pending results are written first, and the
+// file is indexed again on the next lookup, so a later flush() never mistakes
+// the emptied set for the file's contents and compacts the file down to it.
+void PositionCache::clear() {
+    flush();
+    entries.clear();
+    pending.clear();
+    loaded = false;
+    rewriteNeeded = false;
+    fileRecords = 0;
+}
+
+void PositionCache::setPersistent(bool enabled) {
+    persistent = enabled;
+    if (!persistent) {
+        pending.clear();
+    }
+}
+
+size_t PositionCache::getEntryCount() const {
+    return entries.size();
+}
+
+uint64_t PositionCache::makeKey(const Board& board, CellState toMove) {
+    uint64_t key = board.getHash();
+    return (toMove == PLAYER_O) ? key ^ SIDE_TO_MOVE_KEY : key;
+}
+
+std::string PositionCache::getFileName(int size, int winCond) {
+    std::stringstream ss;
+    ss << "ai_cache_" << size << "x" << size << "_" << winCond << ".bin";
+    return ss.str();
+}
+
+void PositionCache::load() {
+    loaded = true;
+    rewriteNeeded = false;
+    fileRecords = 0;
+    if (!persistent || boardSize == 0) return;
+    
+    MappedFile file;
+    if (!file.open(getFileName(boardSize, winCondition))) {
+        return; // No cache yet
+    }
+    
+    if (file.size() < sizeof(CacheHeader)) return;
+    
+    CacheHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION ||
+        (int)header.boardSize != boardSize || (int)header.winCondition != winCondition) {
+        return; // Stale or foreign file; it is replaced on the next compaction
+    }
+    
+    // Index every record; later and deeper results supersede earlier ones. A
+    // torn record at the end (from a crash mid-append) is skipped, and the
+    // file is rewritten on the next flush so appends stay record-aligned.
+    size_t count = (file.size() - sizeof(CacheHeader)) / sizeof(CacheRecord);
+    rewriteNeeded = (file.size() - sizeof(CacheHeader)) % sizeof(CacheRecord) != 0;
+    const unsigned char* data = file.data() + sizeof(CacheHeader);
+    entries.reserve(entries.size() + count);
+    
+    for (size_t i = 0; i < count; i++) {
+        CacheRecord record;
+        std::memcpy(&record, data + i * sizeof(CacheRecord), sizeof(record));
+        
+        auto it = entries.find(record.key);
+        if (it == entries.end() || it->second.depth <= record.depth) {
+            entries[record.key] = record;
+        }
+    }
+    
+    fileRecords = count;
+}
+
+bool PositionCache::writeFile(const std::string& filename, const std::vector<CacheRecord>& records) const {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.boardSize = (uint32_t)boardSize;
+    header.winCondition = (uint32_t)winCondition;
+    
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!records.empty()) {
+        file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(CacheRecord));
+    }
+    return (bool)file;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef POSITIONCACHE_H
+#define POSITIONCACHE_H
+
+#include "Board.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Persistent cache settings
+const int POSITION_CACHE_MIN_SAVED_DEPTH = 2;         // Shallower results are cheap to recompute
+const size_t POSITION_CACHE_MAX_RECORDS = 1 << 20;    // Size cap (16 bytes per record)
+
+// One search result as stored on disk
+struct CacheRecord {
+    uint64_t key;
+    int16_t score;      // From the side to move's point of view, relative to this position
+    uint8_t depth;      // Remaining search depth the score was computed with
+    uint8_t bestMove;   // Cell index (row * size + col), or CACHE_NO_MOVE
+    uint32_t reserved;
+};
+
+const uint8_t CACHE_NO_MOVE = 0xFF;
+
+// Search results keyed by position, kept per (boardSize, winCondition) in
+// an append-only file. The file is memory-mapped and indexed on the first
+// lookup; new results are appended when flush() is called at game end.
+class PositionCache {
+public:
+    PositionCache();
+    ~PositionCache();
+    
+    // Select the file for this board configuration (flushes the previous one)
+    void configure(int boardSize, int winCondition);
+    
+    bool lookup(uint64_t key, int depth, int& score, int& bestMove);
+    void store(uint64_t key, int depth, int score, int bestMove);
+    
+    // Append pending results to disk, compacting when the file grows too large
+    bool flush();
+    bool compact();
+    // Forget the in-memory results; the file is kept and reloaded on demand
+    void clear();
+    
+    void setPersistent(bool enabled);
+    size_t getEntryCount() const;
+    
+    // Position key including the side to move
+    static uint64_t makeKey(const Board& board, CellState toMove);
+    static std::string getFileName(int boardSize, int winCondition);
+    
+private:
+    std::unordered_map<uint64_t, CacheRecord> entries;
+    std::vector<CacheRecord> pending;
+    int boardSize;
+    int winCondition;
+    bool loaded;
+    bool persistent;
+    bool rewriteNeeded;    // The file ends in a torn record, so it can't be appended to
+    size_t fileRecords;
+    
+    void load();
+    bool writeFile(const std::string& filename, const std::vector<CacheRecord>& records) const;
+};
+
+#endif
\ No newline at end of file
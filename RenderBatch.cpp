@@ -0,0 +1,169 @@
+#include "RenderBatch.h"
+#include <algorithm>
+#include <functional>
+
+RenderBatch::RenderBatch() : geometrySupported(SDL_VERSION_ATLEAST(2, 0, 18)), drawCalls(0), primitives(0) {}
+
+void RenderBatch::addRect(RenderLayer layer, const SDL_Rect& rect, SDL_Color color, SDL_BlendMode blend) {
+    SDL_FRect dest = {(float)rect.x, (float)rect.y, (float)rect.w, (float)rect.h};
+    addTexturedRect(layer, nullptr, dest, 0.0f, 0.0f, 0.0f, 0.0f, color, blend);
+}
+
+void RenderBatch::addRectOutline(RenderLayer layer, const SDL_Rect& rect, SDL_Color color, SDL_BlendMode blend) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+
+    SDL_Rect top = {rect.x, rect.y, rect.w, 1};
+    SDL_Rect bottom = {rect.x, rect.y + rect.h - 1, rect.w, 1};
+    SDL_Rect left = {rect.x, rect.y + 1, 1, rect.h - 2};
+    SDL_Rect right = {rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2};
+    addRect(layer, top, color, blend);
+    addRect(layer, bottom, color, blend);
+    if (rect.h > 2) {
+        addRect(layer, left, color, blend);
+        addRect(layer, right, color, blend);
+    }
+}
+
+void RenderBatch::addTexturedRect(RenderLayer layer, SDL_Texture* texture, const SDL_FRect& dest, float u0,
+                                  float v0, float u1, float v1, SDL_Color color, SDL_BlendMode blend) {
+    Command command;
+    command.layer = layer;
+    command.order = (int)commands.size();
+    command.texture = texture;
+    command.blend = blend;
+    command.dest = dest;
+    command.u0 = u0;
+    command.v0 = v0;
+    command.u1 = u1;
+    command.v1 = v1;
+    command.color = color;
+    commands.push_back(command);
+}
+
+void RenderBatch::clear() {
+    commands.clear();
+}
+
+bool RenderBatch::isEmpty() const {
+    return commands.empty();
+}
+
+unsigned long long RenderBatch::getDrawCallCount() const {
+    return drawCalls;
+}
+
+unsigned long long RenderBatch::getPrimitiveCount() const {
+    return primitives;
+}
+
+void RenderBatch::flush(SDL_Renderer* renderer) {
+    if (commands.empty()) return;
+    primitives += commands.size();
+
+    // std::sort with the insertion order as the last key is stable without
+    // the temporary buffer std::stable_sort allocates
+    std::sort(commands.begin(), commands.end(), [](const Command& a, const Command& b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (a.texture != b.texture) return std::less<SDL_Texture*>()(a.texture, b.texture);
+        if (a.blend != b.blend) return a.blend < b.blend;
+        return a.order < b.order;
+    });
+
+    if (!geometrySupported) {
+        for (const auto& command : commands) {
+            drawDirect(renderer, command);
+        }
+        commands.clear();
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        return;
+    }
+
+    vertices.clear();
+    indices.clear();
+    size_t runStart = 0;
+    for (size_t i = 0; i < commands.size(); i++) {
+        const Command& command = commands[i];
+
+        int base = (int)vertices.size();
+        SDL_Vertex corner;
+        corner.color = command.color;
+        corner.position = {command.dest.x, command.dest.y};
+        corner.tex_coord = {command.u0, command.v0};
+        vertices.push_back(corner);
+        corner.position = {command.dest.x + command.dest.w, command.dest.y};
+        corner.tex_coord = {command.u1, command.v0};
+        vertices.push_back(corner);
+        corner.position = {command.dest.x + command.dest.w, command.dest.y + command.dest.h};
+        corner.tex_coord = {command.u1, command.v1};
+        vertices.push_back(corner);
+        corner.position = {command.dest.x, command.dest.y + command.dest.h};
+        corner.tex_coord = {command.u0, command.v1};
+        vertices.push_back(corner);
+
+        int quad[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+        indices.insert(indices.end(), quad, quad + 6);
+
+        // Runs of the same texture and blend mode share one call, even across layers
+        bool lastOfRun = (i + 1 == commands.size()) || commands[i + 1].texture != command.texture ||
+                         commands[i + 1].blend != command.blend;
+        if (!lastOfRun) continue;
+
+        if (!submit(renderer, command.texture, command.blend)) {
+            // The renderer rejected geometry; draw directly from now on
+            geometrySupported = false;
+            for (size_t j = runStart; j < commands.size(); j++) {
+                drawDirect(renderer, commands[j]);
+            }
+            break;
+        }
+        runStart = i + 1;
+    }
+    commands.clear();
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
+
+bool RenderBatch::submit(SDL_Renderer* renderer, SDL_Texture* texture, SDL_BlendMode blend) {
+    bool drawn = false;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (texture) {
+        SDL_SetTextureBlendMode(texture, blend);
+    } else {
+        SDL_SetRenderDrawBlendMode(renderer, blend);
+    }
+
+    drawCalls++;
+    drawn = SDL_RenderGeometry(renderer, texture, &vertices[0], (int)vertices.size(), &indices[0],
+                               (int)indices.size()) == 0;
+#else
+    (void)renderer;
+    (void)texture;
+    (void)blend;
+#endif
+    vertices.clear();
+    indices.clear();
+    return drawn;
+}
+
+void RenderBatch::drawDirect(SDL_Renderer* renderer, const Command& command) {
+    drawCalls++;
+    SDL_Rect dest = {(int)command.dest.x, (int)command.dest.y, (int)command.dest.w, (int)command.dest.h};
+
+    if (!command.texture) {
+        SDL_SetRenderDrawBlendMode(renderer, command.blend);
+        SDL_SetRenderDrawColor(renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+        SDL_RenderFillRect(renderer, &dest);
+        return;
+    }
+
+    int width, height;
+    SDL_QueryTexture(command.texture, nullptr, nullptr, &width, &height);
+    SDL_Rect source = {(int)(command.u0 * width + 0.5f), (int)(command.v0 * height + 0.5f),
+                       (int)((command.u1 - command.u0) * width + 0.5f), (int)((command.v1 - command.v0) * height + 0.5f)};
+
+    SDL_SetTextureBlendMode(command.texture, command.blend);
+    SDL_SetTextureColorMod(command.texture, command.color.r, command.color.g, command.color.b);
+    SDL_SetTextureAlphaMod(command.texture, command.color.a);
+    SDL_RenderCopy(renderer, command.texture, &source, &dest);
+    SDL_SetTextureColorMod(command.texture, 255, 255, 255);
+    SDL_SetTextureAlphaMod(command.texture, 255);
+}
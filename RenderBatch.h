@@ -0,0 +1,75 @@
+#ifndef RENDERBATCH_H
+#define RENDERBATCH_H
+
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+// Draw order of batched primitives. Within a layer primitives are grouped
+// by texture and blend mode, so primitives that overlap must either share
+// both (then they keep the order they were added in) or go in separate layers.
+enum RenderLayer {
+    LAYER_BACKGROUND,    // Button fills and borders, grid lines
+    LAYER_PIECES,
+    LAYER_HIGHLIGHTS,    // Winning cells
+    LAYER_ANIMATIONS,    // Animated pieces
+    LAYER_WIN_LINE,      // Win line pulse, over the last piece's animation
+    LAYER_TEXT,
+    LAYER_OVERLAY,       // Move hints, screen fades
+    LAYER_PROFILER,      // Profiler overlay panel
+    LAYER_PROFILER_GRAPH,
+    LAYER_PROFILER_TEXT
+};
+
+// Per-frame command buffer of solid and textured quads. Nothing is drawn
+// while commands are added; flush() sorts them by (layer, texture, blend
+// mode), keeping the order they were added in otherwise, and submits each
+// run of equal texture and blend mode as one SDL_RenderGeometry call.
+// Buffers are reused, so a steady frame allocates nothing. Without
+// SDL_RenderGeometry (SDL < 2.0.18, or a renderer that rejects it) the
+// commands are drawn one by one instead.
+class RenderBatch {
+public:
+    RenderBatch();
+
+    void addRect(RenderLayer layer, const SDL_Rect& rect, SDL_Color color,
+                 SDL_BlendMode blend = SDL_BLENDMODE_NONE);
+    // One-pixel border, like SDL_RenderDrawRect
+    void addRectOutline(RenderLayer layer, const SDL_Rect& rect, SDL_Color color,
+                        SDL_BlendMode blend = SDL_BLENDMODE_NONE);
+    // Texture region (u, v in 0..1) tinted by color, whose alpha fades it
+    void addTexturedRect(RenderLayer layer, SDL_Texture* texture, const SDL_FRect& dest, float u0, float v0,
+                         float u1, float v1, SDL_Color color, SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+
+    // Draw everything added since the last flush
+    void flush(SDL_Renderer* renderer);
+    // Drop everything added since the last flush
+    void clear();
+    bool isEmpty() const;
+
+    unsigned long long getDrawCallCount() const;   // Since construction
+    unsigned long long getPrimitiveCount() const;
+
+private:
+    struct Command {
+        int layer;
+        int order;            // Tie-breaker that keeps the sort stable
+        SDL_Texture* texture; // nullptr for solid quads
+        SDL_BlendMode blend;
+        SDL_FRect dest;
+        float u0, v0, u1, v1;
+        SDL_Color color;
+    };
+
+    std::vector<Command> commands;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    bool geometrySupported;
+    unsigned long long drawCalls;
+    unsigned long long primitives;
+
+    bool submit(SDL_Renderer* renderer, SDL_Texture* texture, SDL_BlendMode blend);
+    void drawDirect(SDL_Renderer* renderer, const Command& command);
+};
+
+#endif
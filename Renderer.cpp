@@ -2,13 +2,24 @@
 #include "UIButton.h"
 #include <iostream>
 #include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-Renderer::Renderer() : renderer(nullptr), titleFont(nullptr), buttonFont(nullptr), 
-                       statusFont(nullptr), gridStartX(0), gridStartY(0), cellSize(0) {}
+Renderer::Renderer() : renderer(nullptr), profiler(nullptr), directDrawCalls(0), textureUploads(0),
+                       reportedDrawCalls(0), reportedUploads(0), titleFont(nullptr), buttonFont(nullptr), 
+                       statusFont(nullptr), gridStartX(0), gridStartY(0), cellSize(0), spriteCellSize(0),
+                       boardLayer(nullptr), boardLayerSize(0), boardLayerCellSize(0),
+                       animationPool(ANIMATION_POOL_SIZE) {
+    pieceSprites[0] = nullptr;
+    pieceSprites[1] = nullptr;
+    activeAnimations.reserve(ANIMATION_POOL_SIZE);
+}
 
 Renderer::~Renderer() {
     cleanup();
@@ -16,6 +27,7 @@ Renderer::~Renderer() {
 
 bool Renderer::initialize(SDL_Renderer* sdlRenderer) {
     renderer = sdlRenderer;
+    textCache.setRenderer(renderer);
     
     // Try to load fonts - use system default if not available
     titleFont = TTF_OpenFont("arial.ttf", FONT_SIZE_TITLE);
@@ -37,10 +49,22 @@ bool Renderer::initialize(SDL_Renderer* sdlRenderer) {
         std::cout << "Warning: Could not load fonts. Text rendering may be limited." << std::endl;
     }
     
+    // Without atlases (old SDL) text falls back to cached string textures
+    titleAtlas.build(renderer, titleFont);
+    buttonAtlas.build(renderer, buttonFont);
+    statusAtlas.build(renderer, statusFont);
+    
     return true;
 }
 
 void Renderer::cleanup() {
+    textCache.clear(); // Cached textures are keyed by font
+    titleAtlas.release();
+    buttonAtlas.release();
+    statusAtlas.release();
+    releasePieceSprites();
+    releaseBoardLayer();
+    
     if (titleFont) {
         TTF_CloseFont(titleFont);
         titleFont = nullptr;
@@ -56,19 +80,44 @@ void Renderer::cleanup() {
 }
 
 void Renderer::clearScreen() {
+    ScopedProfileTimer timer(profiler, PROFILE_CLEAR);
     SDL_SetRenderDrawColor(renderer, COLOR_BG_PRIMARY.r, COLOR_BG_PRIMARY.g, 
                           COLOR_BG_PRIMARY.b, COLOR_BG_PRIMARY.a);
     SDL_RenderClear(renderer);
 }
 
 void Renderer::present() {
+    ScopedProfileTimer timer(profiler, PROFILE_PRESENT);
+    renderScreenTransition();
+    batch.flush(renderer);
+    reportFrameCounters();
     SDL_RenderPresent(renderer);
 }
 
+void Renderer::setProfiler(FrameProfiler* frameProfiler) {
+    profiler = frameProfiler;
+}
+
+// Hands the profiler what was drawn and uploaded since the last frame
+void Renderer::reportFrameCounters() {
+    unsigned long long drawCalls = batch.getDrawCallCount() + layerBatch.getDrawCallCount() + directDrawCalls;
+    unsigned long long uploads = textCache.getMissCount() + textureUploads;
+    if (profiler) {
+        profiler->addCount(PROFILE_DRAW_CALLS, drawCalls - reportedDrawCalls);
+        profiler->addCount(PROFILE_TEXTURE_UPLOADS, uploads - reportedUploads);
+    }
+    reportedDrawCalls = drawCalls;
+    reportedUploads = uploads;
+}
+
 void Renderer::setGridDimensions(int startX, int startY, int size) {
     gridStartX = startX;
     gridStartY = startY;
     cellSize = size;
+    
+    if (cellSize != spriteCellSize) {
+        rebuildPieceSprites();
+    }
 }
 
 void Renderer::renderMenu(const std::vector<UIButton>& buttons, const std::string& difficultyText) {
@@ -82,6 +131,8 @@ void Renderer::renderMenu(const std::vector<UIButton>& buttons, const std::strin
     
     // Render AI difficulty indicator
     renderText(difficultyText, 400, 50, FONT_SIZE_STATUS, COLOR_TEXT);
+    
+    renderText("S: settings and AI move times", 400, 585, FONT_SIZE_SMALL, COLOR_TEXT);
 }
 
 void Renderer::renderBoardSizeSelection(const std::vector<UIButton>& buttons, int selectedSize) {
@@ -112,15 +163,14 @@ void Renderer::renderBoardSizeSelection(const std::vector<UIButton>& buttons, in
     }
 }
 
-void Renderer::renderGame(const Board& board, const std::vector<UIButton>& buttons, 
-                         const std::string& statusMessage, CellState currentPlayer, bool gameEnded) {
+void Renderer::renderGame(const Board& board, const WinInfo& winInfo, const std::vector<UIButton>& buttons,
+                          const std::string& statusMessage, const std::string& turnMessage, CellState currentPlayer) {
     // Render game buttons
     for (const auto& button : buttons) {
         renderButton(button);
     }
     
     // Render board
-    WinInfo winInfo = board.checkWin();
     renderBoard(board, winInfo);
     
     // Render status message
@@ -129,18 +179,17 @@ void Renderer::renderGame(const Board& board, const std::vector<UIButton>& butto
     }
     
     // Render current player indicator
-    if (!gameEnded) {
-        std::string playerText = "Current Player: ";
-        playerText += (currentPlayer == PLAYER_X) ? "X" : "O";
+    if (!turnMessage.empty()) {
         SDL_Color playerColor = (currentPlayer == PLAYER_X) ? COLOR_PLAYER_X : COLOR_PLAYER_O;
-        renderText(playerText, 400, 450, FONT_SIZE_STATUS, playerColor);
+        renderText(turnMessage, 400, 450, FONT_SIZE_STATUS, playerColor);
     }
     
-    // Update and render animations
-    updateAnimations();
+    // Render animations
+    renderBoardAnimations();
 }
 
-void Renderer::renderSettings(const std::vector<UIButton>& buttons, int currentAILevel) {
+void Renderer::renderSettings(const std::vector<UIButton>& buttons, int currentAILevel,
+                              const std::vector<std::string>& latencyLines) {
     // Render title
     renderText("SETTINGS", 400, 100, FONT_SIZE_TITLE, COLOR_TEXT);
     
@@ -151,26 +200,92 @@ void Renderer::renderSettings(const std::vector<UIButton>& buttons, int currentA
     for (const auto& button : buttons) {
         renderButton(button);
     }
+    
+    // Move time percentiles of the selected level, one line per board size
+    renderText("AI Move Time", 400, 475, FONT_SIZE_SMALL, COLOR_TEXT);
+    for (size_t i = 0; i < latencyLines.size(); i++) {
+        renderText(latencyLines[i], 400, 500 + (int)i * 22, FONT_SIZE_SMALL, COLOR_TEXT);
+    }
+}
+
+void Renderer::renderMoveHints(const std::vector<MoveAnalysis>& analysis) {
+    if (analysis.empty()) return;
+    
+    int bestScore = analysis[0].score;
+    for (const auto& move : analysis) {
+        bestScore = std::max(bestScore, move.score);
+    }
+    
+    for (const auto& move : analysis) {
+        // Winning moves are tinted with the win colour, losing moves with X's red
+        SDL_Color color = COLOR_GRID;
+        if (move.score > 0) {
+            color = COLOR_WIN_HIGHLIGHT;
+        } else if (move.score < 0) {
+            color = COLOR_PLAYER_X;
+        }
+        
+        // Faster wins and losses are drawn more opaque
+        float strength = std::min(std::abs(move.score), 10) / 10.0f;
+        Uint8 alpha = (Uint8)(40 + 120 * strength);
+        
+        SDL_Rect cell = {gridStartX + move.col * cellSize + 4, gridStartY + move.row * cellSize + 4,
+                        cellSize - 8, cellSize - 8};
+        color.a = alpha;
+        batch.addRect(LAYER_OVERLAY, cell, color, SDL_BLENDMODE_BLEND);
+        
+        // Outline the recommended move(s)
+        if (move.score == bestScore) {
+            batch.addRectOutline(LAYER_OVERLAY, cell, COLOR_TEXT, SDL_BLENDMODE_BLEND);
+        }
+    }
 }
 
 void Renderer::renderBoard(const Board& board, const WinInfo& winInfo) {
+    ScopedProfileTimer timer(profiler, PROFILE_BOARD);
     int boardSize = board.getSize();
     
-    // Draw grid lines
-    SDL_SetRenderDrawColor(renderer, COLOR_GRID.r, COLOR_GRID.g, COLOR_GRID.b, COLOR_GRID.a);
+    // Grid and pieces come from the cached layer when render targets work
+    if (updateBoardLayer(board)) {
+        float boardPixels = (float)(boardSize * cellSize);
+        SDL_FRect dest = {(float)gridStartX, (float)gridStartY, boardPixels, boardPixels};
+        SDL_Color white = {255, 255, 255, 255};
+        batch.addTexturedRect(LAYER_PIECES, boardLayer, dest, 0.0f, 0.0f, 1.0f, 1.0f, white, SDL_BLENDMODE_NONE);
+    } else {
+        renderGridAndPieces(board);
+    }
+    
+    // Highlight winning line if game is over
+    if (winInfo.hasWinner) {
+        SDL_Color color = COLOR_WIN_HIGHLIGHT;
+        color.a = 128; // Semi-transparent
+        
+        for (int cellIndex : winInfo.winningCells) {
+            int row = cellIndex / boardSize;
+            int col = cellIndex % boardSize;
+            SDL_Rect highlight = {gridStartX + col * cellSize + 10, 
+                                 gridStartY + row * cellSize + 10,
+                                 cellSize - 20, cellSize - 20};
+            batch.addRect(LAYER_HIGHLIGHTS, highlight, color);
+        }
+    }
+}
+
+void Renderer::renderGridAndPieces(const Board& board) {
+    int boardSize = board.getSize();
     
     // Vertical lines
     for (int i = 1; i < boardSize; i++) {
         SDL_Rect line = {gridStartX + i * cellSize - GRID_LINE_THICKNESS/2, gridStartY, 
                         GRID_LINE_THICKNESS, cellSize * boardSize};
-        SDL_RenderFillRect(renderer, &line);
+        batch.addRect(LAYER_BACKGROUND, line, COLOR_GRID);
     }
     
     // Horizontal lines
     for (int i = 1; i < boardSize; i++) {
         SDL_Rect line = {gridStartX, gridStartY + i * cellSize - GRID_LINE_THICKNESS/2, 
                         cellSize * boardSize, GRID_LINE_THICKNESS};
-        SDL_RenderFillRect(renderer, &line);
+        batch.addRect(LAYER_BACKGROUND, line, COLOR_GRID);
     }
     
     // Draw pieces
@@ -182,28 +297,101 @@ void Renderer::renderBoard(const Board& board, const WinInfo& winInfo) {
             }
         }
     }
+}
+
+// Brings the board layer up to date, redrawing only the cells that changed
+// since the last frame; everything is redrawn when the board size or cell
+// size changes. Returns false if the layer can't be used.
+bool Renderer::updateBoardLayer(const Board& board) {
+    int boardSize = board.getSize();
+    int boardPixels = boardSize * cellSize;
+    if (!renderer || boardPixels <= 0 || !pieceSprites[0] || !pieceSprites[1]) return false;
     
-    // Highlight winning line if game is over
-    if (winInfo.hasWinner) {
-        SDL_SetRenderDrawColor(renderer, COLOR_WIN_HIGHLIGHT.r, COLOR_WIN_HIGHLIGHT.g, 
-                              COLOR_WIN_HIGHLIGHT.b, 128); // Semi-transparent
+    bool rebuild = !boardLayer || boardSize != boardLayerSize || cellSize != boardLayerCellSize;
+    if (rebuild) {
+        releaseBoardLayer();
+        if (!SDL_RenderTargetSupported(renderer)) return false;
         
-        for (int cellIndex : winInfo.winningCells) {
-            int row = cellIndex / boardSize;
-            int col = cellIndex % boardSize;
-            SDL_Rect highlight = {gridStartX + col * cellSize + 10, 
-                                 gridStartY + row * cellSize + 10,
-                                 cellSize - 20, cellSize - 20};
-            SDL_RenderFillRect(renderer, &highlight);
+        boardLayer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                       boardPixels, boardPixels);
+        if (!boardLayer) return false;
+        boardLayerSize = boardSize;
+        boardLayerCellSize = cellSize;
+        boardLayerCells.assign(boardSize * boardSize, EMPTY);
+    }
+    
+    for (int row = 0; row < boardSize; row++) {
+        for (int col = 0; col < boardSize; col++) {
+            CellState cell = board.getCell(row, col);
+            CellState& drawn = boardLayerCells[row * boardSize + col];
+            if (rebuild || cell != drawn) {
+                queueBoardLayerCell(row, col, cell);
+                drawn = cell;
+            }
         }
     }
+    if (layerBatch.isEmpty()) return true;
+    
+    if (SDL_SetRenderTarget(renderer, boardLayer) != 0) {
+        layerBatch.clear();
+        releaseBoardLayer();
+        return false;
+    }
+    layerBatch.flush(renderer);
+    SDL_SetRenderTarget(renderer, nullptr);
+    return true;
 }
 
-void Renderer::renderPiece(int row, int col, CellState player, float scale, float alpha) {
+// Queues one cell of the layer in layer coordinates: the background, the
+// parts of the grid lines that cross it (each line straddles two cells) and
+// its piece. The layer is opaque, so it is copied to the screen unblended.
+void Renderer::queueBoardLayerCell(int row, int col, CellState cell) {
+    int boardPixels = boardLayerSize * cellSize;
+    SDL_Rect cellRect = {col * cellSize, row * cellSize, cellSize, cellSize};
+    layerBatch.addRect(LAYER_BACKGROUND, cellRect, COLOR_BG_PRIMARY);
+    
+    for (int i = 1; i < boardLayerSize; i++) {
+        SDL_Rect vertical = {i * cellSize - GRID_LINE_THICKNESS/2, 0, GRID_LINE_THICKNESS, boardPixels};
+        SDL_Rect horizontal = {0, i * cellSize - GRID_LINE_THICKNESS/2, boardPixels, GRID_LINE_THICKNESS};
+        SDL_Rect part;
+        if (SDL_IntersectRect(&vertical, &cellRect, &part)) {
+            layerBatch.addRect(LAYER_BACKGROUND, part, COLOR_GRID);
+        }
+        if (SDL_IntersectRect(&horizontal, &cellRect, &part)) {
+            layerBatch.addRect(LAYER_BACKGROUND, part, COLOR_GRID);
+        }
+    }
+    
+    if (cell != EMPTY) {
+        queuePieceSprite(layerBatch, LAYER_PIECES, col * cellSize + cellSize / 2, row * cellSize + cellSize / 2,
+                         cell, 1.0f, 1.0f);
+    }
+}
+
+void Renderer::invalidateBoardLayer() {
+    boardLayerSize = 0;
+}
+
+void Renderer::releaseBoardLayer() {
+    if (boardLayer) {
+        SDL_DestroyTexture(boardLayer);
+        boardLayer = nullptr;
+    }
+    boardLayerSize = 0;
+    boardLayerCellSize = 0;
+    boardLayerCells.clear();
+}
+
+void Renderer::renderPiece(int row, int col, CellState player, float scale, float alpha, RenderLayer layer) {
     int centerX = gridStartX + col * cellSize + cellSize / 2;
     int centerY = gridStartY + row * cellSize + cellSize / 2;
     int size = (cellSize / 3) * scale;
     
+    if (queuePieceSprite(batch, layer, centerX, centerY, player, scale, alpha)) return;
+    
+    // Drawn immediately, so everything queued before it goes first
+    batch.flush(renderer);
+    
     if (player == PLAYER_X) {
         SDL_Color color = COLOR_PLAYER_X;
         color.a = (Uint8)(255 * alpha);
@@ -222,32 +410,52 @@ void Renderer::renderPiece(int row, int col, CellState player, float scale, floa
     }
 }
 
+bool Renderer::queuePieceSprite(RenderBatch& target, RenderLayer layer, int centerX, int centerY,
+                                CellState player, float scale, float alpha) {
+    SDL_Texture* sprite = (player == PLAYER_X) ? pieceSprites[0] : (player == PLAYER_O) ? pieceSprites[1] : nullptr;
+    if (!sprite) return false;
+    
+    int spriteSize;
+    SDL_QueryTexture(sprite, nullptr, nullptr, &spriteSize, nullptr);
+    int scaledSize = (int)(spriteSize * scale);
+    SDL_FRect dest = {(float)(centerX - scaledSize / 2), (float)(centerY - scaledSize / 2),
+                      (float)scaledSize, (float)scaledSize};
+    SDL_Color tint = {255, 255, 255, (Uint8)(255 * alpha)};
+    target.addTexturedRect(layer, sprite, dest, 0.0f, 0.0f, 1.0f, 1.0f, tint);
+    return true;
+}
+
 void Renderer::renderButton(const UIButton& button) {
-    SDL_Color bgColor = button.isHovered() ? COLOR_BUTTON_HOVER : COLOR_BUTTON_DEFAULT;
+    // Colour and scale follow the hover transition
+    float hover = button.getHoverAnimation();
+    SDL_Color bgColor = {
+        (Uint8)(COLOR_BUTTON_DEFAULT.r + (COLOR_BUTTON_HOVER.r - COLOR_BUTTON_DEFAULT.r) * hover),
+        (Uint8)(COLOR_BUTTON_DEFAULT.g + (COLOR_BUTTON_HOVER.g - COLOR_BUTTON_DEFAULT.g) * hover),
+        (Uint8)(COLOR_BUTTON_DEFAULT.b + (COLOR_BUTTON_HOVER.b - COLOR_BUTTON_DEFAULT.b) * hover),
+        255
+    };
     
     // Apply hover scale
     SDL_Rect rect = button.getRect();
-    if (button.isHovered()) {
-        int scaleIncrease = (int)(rect.w * 0.05f);
-        rect.x -= scaleIncrease / 2;
-        rect.y -= scaleIncrease / 2;
-        rect.w += scaleIncrease;
-        rect.h += scaleIncrease;
-    }
+    int scaleIncrease = (int)(rect.w * (BUTTON_HOVER_SCALE - 1.0f) * hover);
+    rect.x -= scaleIncrease / 2;
+    rect.y -= scaleIncrease / 2;
+    rect.w += scaleIncrease;
+    rect.h += scaleIncrease;
     
     // Draw button background
-    SDL_SetRenderDrawColor(renderer, bgColor.r, bgColor.g, bgColor.b, bgColor.a);
-    SDL_RenderFillRect(renderer, &rect);
+    batch.addRect(LAYER_BACKGROUND, rect, bgColor);
     
     // Draw button border
-    SDL_SetRenderDrawColor(renderer, COLOR_TEXT.r, COLOR_TEXT.g, COLOR_TEXT.b, COLOR_TEXT.a);
-    SDL_RenderDrawRect(renderer, &rect);
+    batch.addRectOutline(LAYER_BACKGROUND, rect, COLOR_TEXT);
     
     // Draw button text
     renderText(button.getText(), rect.x + rect.w/2, rect.y + rect.h/2, FONT_SIZE_BUTTON, COLOR_TEXT);
 }
 
-void Renderer::renderText(const std::string& text, int x, int y, int fontSize, SDL_Color color, bool centered) {
+void Renderer::renderText(const std::string& text, int x, int y, int fontSize, SDL_Color color, bool centered,
+                          RenderLayer layer) {
+    ScopedProfileTimer timer(profiler, PROFILE_TEXT);
     TTF_Font* font = nullptr;
     
     // Select appropriate font based on size with better scaling
@@ -263,17 +471,27 @@ void Renderer::renderText(const std::string& text, int x, int y, int fontSize, S
     }
     
     if (font) {
-        SDL_Texture* textTexture = createTextTexture(text, font, color);
-        if (textTexture) {
+        // Scale down the text if it's using a larger font for smaller font sizes
+        float scale = 1.0f;
+        if (fontSize < FONT_SIZE_STATUS && font == statusFont) {
+            scale = (float)fontSize / FONT_SIZE_STATUS;
+        }
+        
+        // Glyph atlas: queued with the frame, nothing rasterized or uploaded
+        GlyphAtlas& atlas = (font == titleFont) ? titleAtlas : (font == buttonFont) ? buttonAtlas : statusAtlas;
+        if (atlas.canDraw(text)) {
             int textWidth, textHeight;
-            SDL_QueryTexture(textTexture, nullptr, nullptr, &textWidth, &textHeight);
-            
-            // Scale down the text if it's using a larger font for smaller font sizes
-            float scale = 1.0f;
-            if (fontSize < FONT_SIZE_STATUS && font == statusFont) {
-                scale = (float)fontSize / FONT_SIZE_STATUS;
-            }
-            
+            atlas.measure(text, textWidth, textHeight);
+            float drawX = centered ? x - textWidth * scale / 2 : (float)x;
+            float drawY = centered ? y - textHeight * scale / 2 : (float)y;
+            // Whole-pixel positions keep the glyphs sharp
+            atlas.draw(batch, layer, text, (int)drawX, (int)drawY, scale, color);
+            return;
+        }
+        
+        int textWidth, textHeight;
+        SDL_Texture* textTexture = textCache.get(text, font, color, textWidth, textHeight);
+        if (textTexture) {
             int scaledWidth = (int)(textWidth * scale);
             int scaledHeight = (int)(textHeight * scale);
             
@@ -284,12 +502,14 @@ void Renderer::renderText(const std::string& text, int x, int y, int fontSize, S
                 destRect = {x, y, scaledWidth, scaledHeight};
             }
             
+            // Cached textures can be evicted before the next flush, so this
+            // one is drawn now, over everything queued before it
+            batch.flush(renderer);
             SDL_RenderCopy(renderer, textTexture, nullptr, &destRect);
-            SDL_DestroyTexture(textTexture);
+            directDrawCalls++;
         }
     } else {
         // Fallback: simple rectangle representation with smaller size
-        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
         int textWidth = text.length() * (fontSize / 4); // Reduced from /3 to /4
         int textHeight = fontSize * 0.8f; // Reduced height
         
@@ -300,112 +520,173 @@ void Renderer::renderText(const std::string& text, int x, int y, int fontSize, S
             textRect = {x, y, textWidth, textHeight};
         }
         
-        SDL_RenderDrawRect(renderer, &textRect);
+        batch.addRectOutline(layer, textRect, color);
     }
 }
 
-void Renderer::updateAnimations() {
-    Uint32 currentTime = SDL_GetTicks();
-    
-    // Update piece animations
-    for (auto& anim : pieceAnimations) {
-        if (anim.active) {
-            float elapsed = currentTime - anim.startTime;
-            anim.progress = elapsed / PIECE_ANIMATION_DURATION;
+void Renderer::advanceAnimations(float deltaMs) {
+    // Finished animations go back to the pool; the rest keep their order
+    size_t kept = 0;
+    for (size_t i = 0; i < activeAnimations.size(); i++) {
+        Animation* anim = activeAnimations[i];
+        anim->tween.advance(deltaMs);
+        if (anim->tween.isFinished()) {
+            animationPool.release(anim);
+        } else {
+            activeAnimations[kept++] = anim;
+        }
+    }
+    activeAnimations.resize(kept);
+}
+
+void Renderer::renderBoardAnimations() {
+    for (const Animation* anim : activeAnimations) {
+        if (anim->kind == ANIMATION_PIECE) {
+            // Render animated piece
+            float scale = anim->tween.getValue();
+            float alpha = anim->tween.getProgress();
+            renderPiece(anim->row, anim->col, anim->player, scale, alpha, LAYER_ANIMATIONS);
+        } else if (anim->kind == ANIMATION_WIN_LINE) {
+            // Render pulsing win line effect
+            float pulse = 0.5f + 0.5f * sin(anim->tween.getProgress() * M_PI * 4);
+            SDL_Color color = COLOR_WIN_HIGHLIGHT;
+            color.a = (Uint8)(255 * pulse);
             
-            if (anim.progress >= 1.0f) {
-                anim.progress = 1.0f;
-                anim.active = false;
+            for (int i = 0; i < anim->cellCount; i++) {
+                int row = anim->cells[i] / anim->boardSize;
+                int col = anim->cells[i] % anim->boardSize;
+                SDL_Rect highlight = {gridStartX + col * cellSize + 5, 
+                                     gridStartY + row * cellSize + 5,
+                                     cellSize - 10, cellSize - 10};
+                batch.addRect(LAYER_WIN_LINE, highlight, color, SDL_BLENDMODE_BLEND);
             }
-            
-            // Render animated piece
-            float scale = PIECE_START_SCALE + (1.0f - PIECE_START_SCALE) * easeOutBounce(anim.progress);
-            float alpha = anim.progress;
-            renderPiece(anim.row, anim.col, anim.player, scale, alpha);
         }
     }
-    
-    // Update win line animation
-    if (winLineAnim.active) {
-        float elapsed = currentTime - winLineAnim.startTime;
-        winLineAnim.progress = elapsed / WIN_LINE_ANIMATION_DURATION;
-        
-        if (winLineAnim.progress >= 1.0f) {
-            winLineAnim.progress = 1.0f;
-        }
-        
-        // Render pulsing win line effect
-        float pulse = 0.5f + 0.5f * sin(winLineAnim.progress * M_PI * 4);
-        SDL_Color color = COLOR_WIN_HIGHLIGHT;
-        color.a = (Uint8)(255 * pulse);
-        
-        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+}
+
+// The new screen fades in from the background colour
+void Renderer::renderScreenTransition() {
+    for (const Animation* anim : activeAnimations) {
+        if (anim->kind != ANIMATION_SCREEN_FADE) continue;
         
-        // Get board size from the first winning cell to calculate row/col correctly
-        int boardSize = 3; // Default, but this should be passed or stored
-        if (!winLineAnim.winningCells.empty()) {
-            // We need to determine board size - for now assume it's stored somewhere accessible
-            // This is a limitation that should be addressed by passing board size to renderer
-        }
+        SDL_Rect screen = {0, 0, 0, 0};
+        SDL_GetRendererOutputSize(renderer, &screen.w, &screen.h);
+        SDL_Color color = COLOR_BG_PRIMARY;
+        color.a = (Uint8)anim->tween.getValue();
+        batch.addRect(LAYER_OVERLAY, screen, color, SDL_BLENDMODE_BLEND);
+    }
+}
+
+void Renderer::renderProfilerOverlay(const FrameProfiler& frameProfiler) {
+    // Graph segments bottom to top; update and render exclude the phases they contain
+    const char* labels[] = {"events", "update", "AI", "render", "present"};
+    const SDL_Color colors[] = {COLOR_GRID, COLOR_PLAYER_O, COLOR_PLAYER_X, COLOR_WIN_HIGHLIGHT, COLOR_BUTTON_HOVER};
+    const int segmentCount = 5;
+    
+    int outputWidth = 0, outputHeight = 0;
+    SDL_GetRendererOutputSize(renderer, &outputWidth, &outputHeight);
+    int graphWidth = PROFILE_HISTORY_FRAMES * PROFILER_BAR_WIDTH;
+    SDL_Rect panel = {outputWidth - graphWidth - 26, 10, graphWidth + 16, PROFILER_GRAPH_HEIGHT + 82};
+    SDL_Color panelColor = COLOR_BG_SECONDARY;
+    panelColor.a = 220;
+    batch.addRect(LAYER_PROFILER, panel, panelColor, SDL_BLENDMODE_BLEND);
+    
+    char line[64];
+    snprintf(line, sizeof(line), "Frame %.2f ms  %.0f FPS", frameProfiler.getLastFrameTime(PROFILE_FRAME) / 1000.0,
+             frameProfiler.getFramesPerSecond());
+    renderText(line, panel.x + 8, panel.y + 6, FONT_SIZE_SMALL, COLOR_TEXT, false, LAYER_PROFILER_TEXT);
+    snprintf(line, sizeof(line), "Draw calls %llu  Uploads %llu",
+             (unsigned long long)frameProfiler.getLastFrameCount(PROFILE_DRAW_CALLS),
+             (unsigned long long)frameProfiler.getLastFrameCount(PROFILE_TEXTURE_UPLOADS));
+    renderText(line, panel.x + 8, panel.y + 26, FONT_SIZE_SMALL, COLOR_TEXT, false, LAYER_PROFILER_TEXT);
+    
+    // Legend
+    int legendX = panel.x + 8;
+    for (int i = 0; i < segmentCount; i++) {
+        SDL_Rect swatch = {legendX, panel.y + 50, 8, 8};
+        batch.addRect(LAYER_PROFILER_GRAPH, swatch, colors[i]);
+        renderText(labels[i], legendX + 11, panel.y + 46, FONT_SIZE_SMALL * 3 / 4, COLOR_TEXT, false,
+                   LAYER_PROFILER_TEXT);
+        legendX += 11 + (int)strlen(labels[i]) * 6 + 5;  // About 6 pixels per character at this size
+    }
+    
+    // One stacked bar per frame, newest on the right
+    int graphBottom = panel.y + panel.h - 8;
+    float pixelsPerMicrosecond = PROFILER_GRAPH_HEIGHT / PROFILER_GRAPH_RANGE;
+    for (int framesAgo = 0; framesAgo < frameProfiler.getHistorySize(); framesAgo++) {
+        double update = frameProfiler.getHistoryTime(framesAgo, PROFILE_UPDATE);
+        double ai = frameProfiler.getHistoryTime(framesAgo, PROFILE_AI);
+        double render = frameProfiler.getHistoryTime(framesAgo, PROFILE_RENDER);
+        double present = frameProfiler.getHistoryTime(framesAgo, PROFILE_PRESENT);
+        double segments[] = {frameProfiler.getHistoryTime(framesAgo, PROFILE_EVENTS), std::max(0.0, update - ai),
+                             ai, std::max(0.0, render - present), present};
         
-        for (int cellIndex : winLineAnim.winningCells) {
-            int row = cellIndex / winLineAnim.boardSize;
-            int col = cellIndex % winLineAnim.boardSize;
-            SDL_Rect highlight = {gridStartX + col * cellSize + 5, 
-                                 gridStartY + row * cellSize + 5,
-                                 cellSize - 10, cellSize - 10};
-            SDL_RenderFillRect(renderer, &highlight);
+        int x = panel.x + 8 + graphWidth - (framesAgo + 1) * PROFILER_BAR_WIDTH;
+        int y = graphBottom;
+        for (int i = 0; i < segmentCount && y > graphBottom - PROFILER_GRAPH_HEIGHT; i++) {
+            int height = (int)(segments[i] * pixelsPerMicrosecond + 0.5);
+            height = std::min(height, y - (graphBottom - PROFILER_GRAPH_HEIGHT));
+            if (height <= 0) continue;
+            y -= height;
+            SDL_Rect bar = {x, y, PROFILER_BAR_WIDTH, height};
+            batch.addRect(LAYER_PROFILER_GRAPH, bar, colors[i]);
         }
     }
+    
+    // 60 FPS budget line
+    SDL_Rect budget = {panel.x + 8, graphBottom - (int)(FRAME_DELAY * 1000 * pixelsPerMicrosecond), graphWidth, 1};
+    batch.addRect(LAYER_PROFILER_TEXT, budget, COLOR_TEXT);
 }
 
-void Renderer::startPieceAnimation(int row, int col, CellState player) {
-    PieceAnimation anim;
-    anim.row = row;
-    anim.col = col;
-    anim.player = player;
-    anim.progress = 0.0f;
-    anim.startTime = SDL_GetTicks();
-    anim.active = true;
+// Takes a slot from the pool, or recycles the oldest running animation
+// once ANIMATION_POOL_SIZE are running
+Animation* Renderer::startAnimation(AnimationKind kind, float duration, float from, float to, Easing easing) {
+    Animation* anim;
+    if ((int)activeAnimations.size() >= ANIMATION_POOL_SIZE) {
+        anim = activeAnimations.front();
+        activeAnimations.erase(activeAnimations.begin());
+    } else {
+        anim = animationPool.acquire();
+    }
     
-    pieceAnimations.push_back(anim);
+    anim->kind = kind;
+    anim->tween.start(from, to, duration, easing);
+    activeAnimations.push_back(anim);
+    return anim;
+}
+
+void Renderer::startPieceAnimation(int row, int col, CellState player) {
+    Animation* anim = startAnimation(ANIMATION_PIECE, PIECE_ANIMATION_DURATION, PIECE_START_SCALE, 1.0f,
+                                     EASE_OUT_BOUNCE);
+    anim->row = row;
+    anim->col = col;
+    anim->player = player;
 }
 
 void Renderer::startWinLineAnimation(const std::vector<int>& winningCells, int boardSize) {
-    winLineAnim.winningCells = winningCells;
-    winLineAnim.progress = 0.0f;
-    winLineAnim.startTime = SDL_GetTicks();
-    winLineAnim.active = true;
-    winLineAnim.boardSize = boardSize;
+    Animation* anim = startAnimation(ANIMATION_WIN_LINE, WIN_LINE_ANIMATION_DURATION, 0.0f, 1.0f, EASE_LINEAR);
+    anim->cellCount = std::min((int)winningCells.size(), MAX_BOARD_SIZE);
+    std::copy(winningCells.begin(), winningCells.begin() + anim->cellCount, anim->cells);
+    anim->boardSize = boardSize;
+}
+
+void Renderer::startScreenTransition() {
+    startAnimation(ANIMATION_SCREEN_FADE, MENU_TRANSITION_DURATION, 255.0f, 0.0f, EASE_IN_OUT_QUAD);
 }
 
 void Renderer::clearAllAnimations() {
-    // Clear all piece animations
-    pieceAnimations.clear();
-    
-    // Clear win line animation
-    winLineAnim.active = false;
-    winLineAnim.progress = 0.0f;
-    winLineAnim.winningCells.clear();
-}
-
-float Renderer::easeOutBounce(float t) {
-    if (t < 1.0f / 2.75f) {
-        return 7.5625f * t * t;
-    } else if (t < 2.0f / 2.75f) {
-        t -= 1.5f / 2.75f;
-        return 7.5625f * t * t + 0.75f;
-    } else if (t < 2.5f / 2.75f) {
-        t -= 2.25f / 2.75f;
-        return 7.5625f * t * t + 0.9375f;
-    } else {
-        t -= 2.625f / 2.75f;
-        return 7.5625f * t * t + 0.984375f;
+    for (Animation* anim : activeAnimations) {
+        animationPool.release(anim);
     }
+    activeAnimations.clear();
+}
+
+bool Renderer::hasActiveAnimations() const {
+    return !activeAnimations.empty();
 }
 
-float Renderer::easeInOutQuad(float t) {
-    return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+int Renderer::getActiveAnimationCount() const {
+    return (int)activeAnimations.size();
 }
 
 void Renderer::drawThickLine(int x1, int y1, int x2, int y2, int thickness, SDL_Color color) {
@@ -414,6 +695,7 @@ void Renderer::drawThickLine(int x1, int y1, int x2, int y2, int thickness, SDL_
     for (int i = -thickness/2; i <= thickness/2; i++) {
         for (int j = -thickness/2; j <= thickness/2; j++) {
             SDL_RenderDrawLine(renderer, x1 + i, y1 + j, x2 + i, y2 + j);
+            directDrawCalls++;
         }
     }
 }
@@ -428,18 +710,72 @@ void Renderer::drawThickCircle(int centerX, int centerY, int radius, int thickne
             int x = centerX + currentRadius * cos(rad);
             int y = centerY + currentRadius * sin(rad);
             SDL_RenderDrawPoint(renderer, x, y);
+            directDrawCalls++;
         }
     }
 }
 
-SDL_Texture* Renderer::createTextTexture(const std::string& text, TTF_Font* font, SDL_Color color) {
-    if (!font) return nullptr;
+void Renderer::rebuildPieceSprites() {
+    releasePieceSprites();
+    if (!renderer || cellSize <= 0) return;
     
-    SDL_Surface* textSurface = TTF_RenderText_Solid(font, text.c_str(), color);
-    if (!textSurface) return nullptr;
-    
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-    SDL_FreeSurface(textSurface);
+    pieceSprites[0] = createPieceSprite(PLAYER_X);
+    pieceSprites[1] = createPieceSprite(PLAYER_O);
+    spriteCellSize = cellSize;
+}
+
+void Renderer::releasePieceSprites() {
+    for (auto& sprite : pieceSprites) {
+        if (sprite) {
+            SDL_DestroyTexture(sprite);
+            sprite = nullptr;
+        }
+    }
+    spriteCellSize = 0;
+}
+
+// Rasterizes a piece at full scale: each pixel's alpha is how far its centre
+// lies inside the strokes, clamped to one pixel of edge, which anti-aliases it
+SDL_Texture* Renderer::createPieceSprite(CellState player) {
+    float size = (float)(cellSize / 3);
+    float halfWidth = PIECE_THICKNESS / 2.0f;
+    int spriteSize = (int)(2 * (size + halfWidth)) + 4;
+    float center = spriteSize / 2.0f;
+    
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, spriteSize, spriteSize, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) return nullptr;
+    
+    SDL_Color color = (player == PLAYER_X) ? COLOR_PLAYER_X : COLOR_PLAYER_O;
+    for (int py = 0; py < spriteSize; py++) {
+        Uint32* pixels = (Uint32*)((Uint8*)surface->pixels + py * surface->pitch);
+        for (int px = 0; px < spriteSize; px++) {
+            float x = px + 0.5f - center;
+            float y = py + 0.5f - center;
+            
+            float coverage;
+            if (player == PLAYER_X) {
+                // Distance to the nearer diagonal, with the strokes ending at +-size
+                float along1 = std::max(-size, std::min(size, (x + y) / 2.0f));
+                float along2 = std::max(-size, std::min(size, (x - y) / 2.0f));
+                float distance1 = std::hypot(x - along1, y - along1);
+                float distance2 = std::hypot(x - along2, y + along2);
+                coverage = halfWidth + 0.5f - std::min(distance1, distance2);
+            } else {
+                // Ring whose outer edge is at size, as the thick circle was
+                float radius = std::hypot(x, y);
+                coverage = std::min(size + 0.5f - radius, radius - (size - halfWidth) + 0.5f);
+            }
+            
+            coverage = std::max(0.0f, std::min(1.0f, coverage));
+            pixels[px] = SDL_MapRGBA(surface->format, color.r, color.g, color.b, (Uint8)(255 * coverage));
+        }
+    }
     
-    return textTexture;
+    SDL_Texture* sprite = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (sprite) {
+        SDL_SetTextureBlendMode(sprite, SDL_BLENDMODE_BLEND);
+        textureUploads++;
+    }
+    return sprite;
 }
\ No newline at end of file
@@ -7,26 +7,33 @@
 #include <string>
 #include <vector>
 #include "Board.h"
+#include "AI.h"
 #include "Constants.h"
+#include "TextTextureCache.h"
+#include "GlyphAtlas.h"
+#include "RenderBatch.h"
+#include "Tween.h"
+#include "ObjectPool.h"
+#include "FrameProfiler.h"
 
-struct PieceAnimation {
-    int row, col;
-    CellState player;
-    float progress;        // 0.0 to 1.0
-    Uint32 startTime;
-    bool active;
-    
-    PieceAnimation() : row(0), col(0), player(EMPTY), progress(0.0f), startTime(0), active(false) {}
+enum AnimationKind {
+    ANIMATION_PIECE,
+    ANIMATION_WIN_LINE,
+    ANIMATION_SCREEN_FADE
 };
 
-struct WinLineAnimation {
-    std::vector<int> winningCells;
-    float progress;        // 0.0 to 1.0
-    Uint32 startTime;
-    bool active;
-    int boardSize;         // Store board size for proper rendering
+// A running tween and what it animates. Pooled: start functions set every
+// field their kind uses.
+struct Animation {
+    AnimationKind kind;
+    Tween tween;
+    int row, col;                  // Piece
+    CellState player;
+    int cells[MAX_BOARD_SIZE];     // Win line
+    int cellCount;
+    int boardSize;
     
-    WinLineAnimation() : progress(0.0f), startTime(0), active(false), boardSize(3) {}
+    Animation() : kind(ANIMATION_PIECE), row(0), col(0), player(EMPTY), cellCount(0), boardSize(3) {}
 };
 
 class Renderer {
@@ -40,47 +47,91 @@ public:
     // Main rendering functions
     void renderMenu(const std::vector<class UIButton>& buttons, const std::string& difficultyText);
     void renderBoardSizeSelection(const std::vector<class UIButton>& buttons, int selectedSize);
-    void renderGame(const Board& board, const std::vector<class UIButton>& buttons, 
-                   const std::string& statusMessage, CellState currentPlayer, bool gameEnded);
-    void renderSettings(const std::vector<class UIButton>& buttons, int currentAILevel);
+    void renderGame(const Board& board, const WinInfo& winInfo, const std::vector<class UIButton>& buttons,
+                    const std::string& statusMessage, const std::string& turnMessage, CellState currentPlayer);
+    void renderSettings(const std::vector<class UIButton>& buttons, int currentAILevel,
+                        const std::vector<std::string>& latencyLines);
+    void renderMoveHints(const std::vector<MoveAnalysis>& analysis);
     
     // Individual rendering functions
     void renderBoard(const Board& board, const WinInfo& winInfo);
-    void renderPiece(int row, int col, CellState player, float scale = 1.0f, float alpha = 1.0f);
+    void renderPiece(int row, int col, CellState player, float scale = 1.0f, float alpha = 1.0f,
+                     RenderLayer layer = LAYER_PIECES);
     void renderButton(const class UIButton& button);
-    void renderText(const std::string& text, int x, int y, int fontSize, SDL_Color color, bool centered = true);
+    void renderText(const std::string& text, int x, int y, int fontSize, SDL_Color color, bool centered = true,
+                    RenderLayer layer = LAYER_TEXT);
+    // Frame time, FPS, a rolling graph of the frame's phases, and draw
+    // calls and texture uploads of the last frame
+    void renderProfilerOverlay(const FrameProfiler& frameProfiler);
     
-    // Animation functions
-    void updateAnimations();
+    // Animation functions. Time only moves through advanceAnimations.
+    void advanceAnimations(float deltaMs);
     void startPieceAnimation(int row, int col, CellState player);
     void startWinLineAnimation(const std::vector<int>& winningCells, int boardSize);
+    void startScreenTransition();
     void clearAllAnimations();
+    bool hasActiveAnimations() const;
+    int getActiveAnimationCount() const;
     
     // Utility functions
     void setGridDimensions(int startX, int startY, int cellSize);
+    void invalidateBoardLayer();   // Redraw the board layer fully, e.g. after SDL_RENDER_TARGETS_RESET
     void clearScreen();
     void present();
+    void setProfiler(FrameProfiler* profiler);   // nullptr (the default) turns timing off
     
 private:
     SDL_Renderer* renderer;
+    FrameProfiler* profiler;
+    unsigned long long directDrawCalls;   // SDL draw calls made outside the batches
+    unsigned long long textureUploads;    // Piece sprites; text uploads are cache misses
+    unsigned long long reportedDrawCalls;
+    unsigned long long reportedUploads;
     TTF_Font* titleFont;
     TTF_Font* buttonFont;
     TTF_Font* statusFont;
+    TextTextureCache textCache;   // Strings the glyph atlases can't draw
+    GlyphAtlas titleAtlas;
+    GlyphAtlas buttonAtlas;
+    GlyphAtlas statusAtlas;
+    RenderBatch batch;            // This frame's quads, drawn by present()
     
     // Grid dimensions
     int gridStartX, gridStartY;
     int cellSize;
     
-    // Animation elements
-    std::vector<PieceAnimation> pieceAnimations;
-    WinLineAnimation winLineAnim;
+    // Anti-aliased X and O for the current cell size, drawn with one copy each
+    SDL_Texture* pieceSprites[2];
+    int spriteCellSize;
+    
+    // Grid and placed pieces, kept in a render target and redrawn per changed cell
+    SDL_Texture* boardLayer;
+    int boardLayerSize;
+    int boardLayerCellSize;
+    std::vector<CellState> boardLayerCells;   // What the layer shows
+    RenderBatch layerBatch;                    // Cells being redrawn into the layer
+    
+    // Animation elements: slots come from a pool sized for every animation
+    // that can run at once; the running ones are listed oldest first
+    ObjectPool<Animation> animationPool;
+    std::vector<Animation*> activeAnimations;
     
     // Helper functions
-    float easeOutBounce(float t);
-    float easeInOutQuad(float t);
+    Animation* startAnimation(AnimationKind kind, float duration, float from, float to, Easing easing);
+    void renderBoardAnimations();
+    void renderScreenTransition();
+    void reportFrameCounters();
     void drawThickLine(int x1, int y1, int x2, int y2, int thickness, SDL_Color color);
     void drawThickCircle(int centerX, int centerY, int radius, int thickness, SDL_Color color);
-    SDL_Texture* createTextTexture(const std::string& text, TTF_Font* font, SDL_Color color);
+    void rebuildPieceSprites();
+    void releasePieceSprites();
+    SDL_Texture* createPieceSprite(CellState player);
+    bool queuePieceSprite(RenderBatch& target, RenderLayer layer, int centerX, int centerY, CellState player,
+                          float scale, float alpha);
+    void renderGridAndPieces(const Board& board);
+    bool updateBoardLayer(const Board& board);
+    void queueBoardLayerCell(int row, int col, CellState cell);
+    void releaseBoardLayer();
 };
 
 #endif
\ No newline at end of file
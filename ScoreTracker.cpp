@@ -1,49 +1,255 @@
 #include "ScoreTracker.h"
+#include <chrono>
 #include <sstream>
-#include <fstream>
-#include <iostream>
 
-ScoreTracker::ScoreTracker() {}
+namespace {
+    const int TOTALS_ROW = HISTORY_SLOT_COUNT;  // Shard row holding the sums over every slot
+    
+    int getOutcome(CellState winner) {
+        return (winner == PLAYER_X) ? 0 : (winner == PLAYER_O) ? 1 : 2;
+    }
+    
+    // Threads take shards round-robin the first time they record
+    int getShardIndex() {
+        static std::atomic<unsigned int> nextShard(0);
+        thread_local unsigned int shard = nextShard.fetch_add(1, std::memory_order_relaxed);
+        return (int)(shard % SCORE_SHARD_COUNT);
+    }
+}
+
+// One recorder thread's counters: X wins, O wins, draws per slot plus a
+// totals row. The padding keeps the next shard's counters off this
+// shard's last cache line.
+struct ScoreTracker::ScoreShard {
+    std::atomic<uint64_t> counts[HISTORY_SLOT_COUNT + 1][3];
+    char padding[SCORE_CACHE_LINE_SIZE];
+    
+    ScoreShard() {
+        reset();
+    }
+    
+    void reset() {
+        for (auto& row : counts) {
+            for (auto& count : row) count.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+ScoreTracker::ScoreTracker()
+    : contextMode(0), contextBoardSize(3), contextLevel(-1), concurrent(false), stopFlusher(false) {}
+
+ScoreTracker::~ScoreTracker() {
+    disableConcurrent();
+}
+
+bool ScoreTracker::openHistory(const std::string& filename) {
+    disableConcurrent();
+    return history.open(filename);
+}
+
+void ScoreTracker::enableConcurrent(int flushIntervalMs) {
+    if (concurrent) return;
+    
+    shards.reset(new ScoreShard[SCORE_SHARD_COUNT]);
+    baseSlots.resize(HISTORY_SLOT_COUNT);
+    for (int slot = 0; slot < HISTORY_SLOT_COUNT; slot++) {
+        baseSlots[slot] = history.getSlotAggregate(slot);
+    }
+    baseTotals = history.getTotals();
+    flushed.assign(HISTORY_SLOT_COUNT, HistoryAggregate());
+    
+    concurrent = true;
+    stopFlusher = false;
+    flusher = std::thread(&ScoreTracker::runFlusher, this, flushIntervalMs);
+}
+
+void ScoreTracker::disableConcurrent() {
+    if (!concurrent) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(flushMutex);
+        stopFlusher = true;
+    }
+    flushSignal.notify_one();
+    flusher.join();
+    
+    // The flusher may have seen stopFlusher before its first pass, so
+    // merge what the shards still hold before dropping them
+    {
+        std::lock_guard<std::mutex> lock(flushMutex);
+        flushLocked();
+    }
+    
+    concurrent = false;
+    shards.reset();
+    baseSlots.clear();
+    flushed.clear();
+}
+
+bool ScoreTracker::isConcurrent() const {
+    return concurrent;
+}
+
+void ScoreTracker::runFlusher(int flushIntervalMs) {
+    std::unique_lock<std::mutex> lock(flushMutex);
+    while (!stopFlusher) {
+        flushSignal.wait_for(lock, std::chrono::milliseconds(flushIntervalMs));
+        flushLocked();
+    }
+}
+
+bool ScoreTracker::flush() {
+    if (!concurrent) return history.checkpoint();
+    
+    std::lock_guard<std::mutex> lock(flushMutex);
+    return flushLocked();
+}
+
+// Moves what the shards counted since the last flush into the history
+bool ScoreTracker::flushLocked() {
+    bool changed = false;
+    for (int slot = 0; slot < HISTORY_SLOT_COUNT; slot++) {
+        HistoryAggregate current = sumShards(slot);
+        HistoryAggregate& done = flushed[slot];
+        if (current.getTotalGames() == done.getTotalGames()) continue;
+        
+        HistoryAggregate delta;
+        delta.xWins = current.xWins - done.xWins;
+        delta.oWins = current.oWins - done.oWins;
+        delta.draws = current.draws - done.draws;
+        history.merge(slot, delta);
+        done = current;
+        changed = true;
+    }
+    
+    if (!changed || !history.isOpen()) return true;
+    return history.checkpoint();
+}
+
+HistoryAggregate ScoreTracker::sumShards(int slot) const {
+    HistoryAggregate sum;
+    for (int shard = 0; shard < SCORE_SHARD_COUNT; shard++) {
+        const std::atomic<uint64_t>* counts = shards[shard].counts[slot];
+        sum.xWins += counts[0].load(std::memory_order_relaxed);
+        sum.oWins += counts[1].load(std::memory_order_relaxed);
+        sum.draws += counts[2].load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+void ScoreTracker::setGameContext(int mode, int boardSize, int aiLevel) {
+    contextMode = mode;
+    contextBoardSize = boardSize;
+    contextLevel = aiLevel;
+}
 
 void ScoreTracker::recordWin(CellState winner) {
-    if (winner == PLAYER_X) {
-        stats.xWins++;
-    } else if (winner == PLAYER_O) {
-        stats.oWins++;
+    if (winner == PLAYER_X || winner == PLAYER_O) {
+        record(contextMode, contextBoardSize, contextLevel, winner);
     }
-    stats.totalGames++;
 }
 
 void ScoreTracker::recordDraw() {
-    stats.draws++;
-    stats.totalGames++;
+    record(contextMode, contextBoardSize, contextLevel, EMPTY);
+}
+
+void ScoreTracker::record(int mode, int boardSize, int aiLevel, CellState winner) {
+    if (!concurrent) {
+        history.record(mode, boardSize, aiLevel, winner);
+        return;
+    }
+    
+    int slot = HistoryStore::getSlot(mode, boardSize, aiLevel);
+    if (slot < 0) return;
+    
+    ScoreShard& shard = shards[getShardIndex()];
+    int outcome = getOutcome(winner);
+    shard.counts[slot][outcome].fetch_add(1, std::memory_order_relaxed);
+    shard.counts[TOTALS_ROW][outcome].fetch_add(1, std::memory_order_relaxed);
 }
 
+// In concurrent mode, games recorded while resetting may survive the reset
 void ScoreTracker::resetStats() {
-    stats = GameStats();
+    moveLatency.clear();
+    saveLatency();
+    
+    if (!concurrent) {
+        history.clear();
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(flushMutex);
+    for (int shard = 0; shard < SCORE_SHARD_COUNT; shard++) {
+        shards[shard].reset();
+    }
+    baseSlots.assign(HISTORY_SLOT_COUNT, HistoryAggregate());
+    baseTotals = HistoryAggregate();
+    flushed.assign(HISTORY_SLOT_COUNT, HistoryAggregate());
+    history.clear();
 }
 
-GameStats ScoreTracker::getStats() const {
+GameStats ScoreTracker::toGameStats(const HistoryAggregate& aggregate) {
+    GameStats stats;
+    stats.xWins = (int)aggregate.xWins;
+    stats.oWins = (int)aggregate.oWins;
+    stats.draws = (int)aggregate.draws;
+    stats.totalGames = (int)aggregate.getTotalGames();
     return stats;
 }
 
+GameStats ScoreTracker::getStats() const {
+    if (!concurrent) return toGameStats(history.getTotals());
+    
+    HistoryAggregate base;
+    {
+        std::lock_guard<std::mutex> lock(flushMutex);  // resetStats() replaces the base
+        base = baseTotals;
+    }
+    
+    HistoryAggregate sum = sumShards(TOTALS_ROW);
+    sum.xWins += base.xWins;
+    sum.oWins += base.oWins;
+    sum.draws += base.draws;
+    return toGameStats(sum);
+}
+
+GameStats ScoreTracker::getStats(int mode, int boardSize, int aiLevel) const {
+    if (!concurrent) return toGameStats(history.getAggregate(mode, boardSize, aiLevel));
+    
+    int slot = HistoryStore::getSlot(mode, boardSize, aiLevel);
+    if (slot < 0) return GameStats();
+    
+    HistoryAggregate base;
+    {
+        std::lock_guard<std::mutex> lock(flushMutex);
+        base = baseSlots[slot];
+    }
+    
+    HistoryAggregate sum = sumShards(slot);
+    sum.xWins += base.xWins;
+    sum.oWins += base.oWins;
+    sum.draws += base.draws;
+    return toGameStats(sum);
+}
+
 int ScoreTracker::getXWins() const {
-    return stats.xWins;
+    return getStats().xWins;
 }
 
 int ScoreTracker::getOWins() const {
-    return stats.oWins;
+    return getStats().oWins;
 }
 
 int ScoreTracker::getDraws() const {
-    return stats.draws;
+    return getStats().draws;
 }
 
 int ScoreTracker::getTotalGames() const {
-    return stats.totalGames;
+    return getStats().totalGames;
 }
 
 std::string ScoreTracker::getScoreString() const {
+    GameStats stats = getStats();
     std::stringstream ss;
     ss << "X: " << stats.xWins << " | O: " << stats.oWins << " | Draws: " << stats.draws;
     return ss.str();
@@ -51,28 +257,39 @@ std::string ScoreTracker::getScoreString() const {
 
 std::string ScoreTracker::getStatsString() const {
     std::stringstream ss;
-    ss << "Games Played: " << stats.totalGames << " | " << getScoreString();
+    ss << "Games Played: " << getTotalGames() << " | " << getScoreString();
     return ss.str();
 }
 
-bool ScoreTracker::saveToFile(const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        return false;
-    }
+void ScoreTracker::openLatency(const std::string& filename) {
+    latencyFile = filename;
+    moveLatency.load(filename);
+}
+
+bool ScoreTracker::saveLatency() const {
+    return !latencyFile.empty() && moveLatency.save(latencyFile);
+}
+
+MoveLatencyTable& ScoreTracker::getMoveLatency() {
+    return moveLatency;
+}
+
+std::string ScoreTracker::getLatencyString(int aiLevel, int boardSize) const {
+    std::string summary = moveLatency.getSummary(aiLevel, boardSize);
+    std::stringstream ss;
+    ss << boardSize << "x" << boardSize << ": " << (summary.empty() ? "no moves yet" : summary);
+    return ss.str();
+}
+
+bool ScoreTracker::saveToFile(const std::string& filename) {
+    if (!concurrent) return history.writeCheckpoint(filename);
     
-    file << stats.xWins << " " << stats.oWins << " " << stats.draws << " " << stats.totalGames;
-    file.close();
-    return true;
+    std::lock_guard<std::mutex> lock(flushMutex);
+    flushLocked();
+    return history.writeCheckpoint(filename);
 }
 
 bool ScoreTracker::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        return false;
-    }
-    
-    file >> stats.xWins >> stats.oWins >> stats.draws >> stats.totalGames;
-    file.close();
-    return true;
+    disableConcurrent();
+    return history.open(filename);
 }
\ No newline at end of file
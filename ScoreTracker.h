@@ -2,7 +2,20 @@
 #define SCORETRACKER_H
 
 #include "Board.h"
+#include "HistoryStore.h"
+#include "LatencyHistogram.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
+
+// Concurrent mode settings
+const int SCORE_SHARD_COUNT = 16;            // Recorder threads beyond this share shards
+const int SCORE_FLUSH_INTERVAL_MS = 1000;    // Background checkpoint period
+const int SCORE_CACHE_LINE_SIZE = 64;
 
 struct GameStats {
     int xWins;
@@ -13,17 +26,43 @@ struct GameStats {
     GameStats() : xWins(0), oWins(0), draws(0), totalGames(0) {}
 };
 
+// Scores are views over a HistoryStore, which keeps results per
+// (mode, board size, AI level); the getters report totals over all of them.
+//
+// In concurrent mode any number of threads may call record() at once.
+// Each thread adds to its own shard of atomic counters (shards are padded
+// so no two share a cache line), getStats() sums the shards, and a
+// background thread merges them into the history and checkpoints it, so
+// recorders never wait on a lock or on the disk.
 class ScoreTracker {
 public:
     ScoreTracker();
+    ~ScoreTracker();
+    
+    // Keep the history on disk (loads what is already there)
+    bool openHistory(const std::string& filename);
+    
+    // Switch modes; call while no other thread is recording. Disabling
+    // stops the flusher after a final flush.
+    void enableConcurrent(int flushIntervalMs = SCORE_FLUSH_INTERVAL_MS);
+    void disableConcurrent();
+    bool isConcurrent() const;
+    
+    // Mode, board size and AI level (-1 = none) of the games recorded next
+    void setGameContext(int mode, int boardSize, int aiLevel);
     
     // Score management
     void recordWin(CellState winner);
     void recordDraw();
+    void record(int mode, int boardSize, int aiLevel, CellState winner);  // Thread-safe in concurrent mode
     void resetStats();
     
+    // Merge concurrent counts into the history and checkpoint it now
+    bool flush();
+    
     // Getters
     GameStats getStats() const;
+    GameStats getStats(int mode, int boardSize, int aiLevel) const;
     int getXWins() const;
     int getOWins() const;
     int getDraws() const;
@@ -33,12 +72,44 @@ public:
     std::string getScoreString() const;
     std::string getStatsString() const;
     
-    // File persistence (optional)
-    bool saveToFile(const std::string& filename) const;
+    // AI move latency per (level, board size); attach it with AI::setLatencyTable
+    void openLatency(const std::string& filename);  // Adds what the file already holds
+    bool saveLatency() const;
+    MoveLatencyTable& getMoveLatency();
+    std::string getLatencyString(int aiLevel, int boardSize) const;
+    
+    // Checkpoint the history to a file / load a history checkpoint
+    bool saveToFile(const std::string& filename);
     bool loadFromFile(const std::string& filename);
     
 private:
-    GameStats stats;
+    struct ScoreShard;
+    
+    HistoryStore history;
+    int contextMode;
+    int contextBoardSize;
+    int contextLevel;
+    MoveLatencyTable moveLatency;
+    std::string latencyFile;
+    
+    // Concurrent mode
+    bool concurrent;
+    std::unique_ptr<ScoreShard[]> shards;
+    std::vector<HistoryAggregate> baseSlots;   // History when concurrent mode started
+    HistoryAggregate baseTotals;
+    std::vector<HistoryAggregate> flushed;     // Shard sums already merged into the history
+    mutable std::mutex flushMutex;             // Guards history, flushed and the base counts (never taken by recorders)
+    std::condition_variable flushSignal;
+    bool stopFlusher;
+    std::thread flusher;
+    
+    ScoreTracker(const ScoreTracker&);
+    ScoreTracker& operator=(const ScoreTracker&);
+    
+    static GameStats toGameStats(const HistoryAggregate& aggregate);
+    void runFlusher(int flushIntervalMs);
+    bool flushLocked();
+    HistoryAggregate sumShards(int slot) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef SERVERPROTOCOL_H
+#define SERVERPROTOCOL_H
+
+// Line protocol shared by game_server and load_client. Every message is one
+// line of text ending in '\n'.
+//
+// Client -> server:
+//   new [size] [win] [easy|medium|hard|neural] [x|o]   start a game (client side, X moves first)
+//   move <row>,<col>                                   play a move
+//   quit
+// Server -> client:
+//   ok                      game started (followed by "move" if the AI is X)
+//   move <row>,<col>        the AI's reply
+//   result x|o|draw         the game is over
+//   error <reason>
+//   error busy              the server is at capacity; the command had no effect
+
+const int SERVER_DEFAULT_PORT = 7878;
+const int SERVER_MAX_LINE = 256;          // Longer input lines close the connection
+const int SERVER_MAX_INPUT = 4096;        // Unread input a session may queue up before it is closed
+const int SERVER_MAX_EVENTS = 256;        // epoll events handled per wakeup
+
+#endif
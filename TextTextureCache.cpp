@@ -0,0 +1,94 @@
+#include "TextTextureCache.h"
+
+TextTextureCache::TextTextureCache(size_t maxBytes)
+    : renderer(nullptr), maxBytes(maxBytes), byteCount(0), hits(0), misses(0) {}
+
+TextTextureCache::~TextTextureCache() {
+    clear();
+}
+
+void TextTextureCache::setRenderer(SDL_Renderer* sdlRenderer) {
+    if (sdlRenderer != renderer) {
+        clear(); // Textures belong to the renderer that created them
+    }
+    renderer = sdlRenderer;
+}
+
+SDL_Texture* TextTextureCache::get(const std::string& text, TTF_Font* font, SDL_Color color, int& width,
+                                   int& height) {
+    if (!renderer || !font || text.empty()) return nullptr;
+
+    // Key: the text, then the font pointer and the color as raw bytes
+    lookupKey.assign(text);
+    lookupKey.append(1, '\0');
+    lookupKey.append(reinterpret_cast<const char*>(&font), sizeof(font));
+    lookupKey.append(reinterpret_cast<const char*>(&color), sizeof(color));
+
+    auto found = index.find(lookupKey);
+    if (found != index.end()) {
+        hits++;
+        entries.splice(entries.begin(), entries, found->second);
+        width = found->second->width;
+        height = found->second->height;
+        return found->second->texture;
+    }
+
+    misses++;
+    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), color);
+    if (!surface) return nullptr;
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (!texture) return nullptr;
+
+    Entry entry;
+    entry.key = lookupKey;
+    entry.texture = texture;
+    SDL_QueryTexture(texture, nullptr, nullptr, &entry.width, &entry.height);
+    entry.bytes = (size_t)entry.width * entry.height * 4;
+
+    entries.push_front(entry);
+    index[entry.key] = entries.begin();
+    byteCount += entry.bytes;
+    evict();
+
+    width = entry.width;
+    height = entry.height;
+    return texture;
+}
+
+// Drops least recently used textures over the cap, always keeping the newest
+void TextTextureCache::evict() {
+    while (byteCount > maxBytes && entries.size() > 1) {
+        Entry& oldest = entries.back();
+        SDL_DestroyTexture(oldest.texture);
+        byteCount -= oldest.bytes;
+        index.erase(oldest.key);
+        entries.pop_back();
+    }
+}
+
+void TextTextureCache::clear() {
+    for (auto& entry : entries) {
+        SDL_DestroyTexture(entry.texture);
+    }
+    entries.clear();
+    index.clear();
+    byteCount = 0;
+}
+
+size_t TextTextureCache::getEntryCount() const {
+    return entries.size();
+}
+
+size_t TextTextureCache::getByteCount() const {
+    return byteCount;
+}
+
+unsigned long long TextTextureCache::getHitCount() const {
+    return hits;
+}
+
+unsigned long long TextTextureCache::getMissCount() const {
+    return misses;
+}
@@ -0,0 +1,59 @@
+#ifndef TEXTTEXTURECACHE_H
+#define TEXTTEXTURECACHE_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// Text cache settings
+const size_t TEXT_CACHE_MAX_BYTES = 8 * 1024 * 1024;   // Texture memory kept (4 bytes per pixel)
+
+// Rendered text textures keyed by (text, font, color). A string is
+// rasterized and uploaded once; later frames reuse the texture. Entries are
+// kept in least-recently-used order and the oldest are destroyed once the
+// textures exceed the memory cap, so strings that change (scores, status
+// lines) age out on their own.
+class TextTextureCache {
+public:
+    TextTextureCache(size_t maxBytes = TEXT_CACHE_MAX_BYTES);
+    ~TextTextureCache();
+
+    void setRenderer(SDL_Renderer* renderer);
+
+    // Texture for the text, rendered on a miss (nullptr if rendering fails).
+    // The cache owns it; it stays valid until the next get() or clear().
+    SDL_Texture* get(const std::string& text, TTF_Font* font, SDL_Color color, int& width, int& height);
+    void clear();
+
+    size_t getEntryCount() const;
+    size_t getByteCount() const;
+    unsigned long long getHitCount() const;
+    unsigned long long getMissCount() const;   // Rasterizations and texture uploads
+
+private:
+    struct Entry {
+        std::string key;
+        SDL_Texture* texture;
+        int width, height;
+        size_t bytes;
+    };
+
+    SDL_Renderer* renderer;
+    size_t maxBytes;
+    size_t byteCount;
+    unsigned long long hits;
+    unsigned long long misses;
+    std::list<Entry> entries;   // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    std::string lookupKey;      // Reused so lookups don't allocate
+
+    TextTextureCache(const TextTextureCache&);
+    TextTextureCache& operator=(const TextTextureCache&);
+
+    void evict();
+};
+
+#endif
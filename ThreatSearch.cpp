@@ -0,0 +1,190 @@
+#include "ThreatSearch.h"
+#include <algorithm>
+
+ThreatSearch::ThreatSearch() : boardSize(0), nodesSearched(0), timedOut(false) {}
+
+std::pair<int, int> ThreatSearch::findForcedWin(const Board& board, CellState attacker, int timeLimitMs,
+                                                int maxDepth) {
+    nodesSearched = 0;
+    timedOut = false;
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeLimitMs);
+
+    boardSize = board.getSize();
+    buildLines(boardSize, board.getWinCondition());
+
+    CellState defender = (attacker == PLAYER_X) ? PLAYER_O : PLAYER_X;
+    Board searchBoard = board;
+
+    // Iterative deepening so the shortest forced win is found first
+    for (int depth = 1; depth <= maxDepth && !timedOut; depth++) {
+        int move = -1;
+        if (search(searchBoard, attacker, defender, depth, move)) {
+            return {move / boardSize, move % boardSize};
+        }
+    }
+
+    return {-1, -1}; // No forced win found within the time slice
+}
+
+int ThreatSearch::getNodesSearched() const {
+    return nodesSearched;
+}
+
+bool ThreatSearch::search(Board& board, CellState attacker, CellState defender, int depth, int& move) {
+    nodesSearched++;
+    if (isTimeUp()) return false;
+
+    // Win immediately if possible
+    std::vector<int> wins = findWinningCells(board, attacker);
+    if (!wins.empty()) {
+        move = wins[0];
+        return true;
+    }
+
+    if (depth <= 0) return false;
+
+    // If the defender threatens to win, the attacker must block with a move
+    // that is itself a threat, otherwise the sequence is no longer forcing
+    std::vector<int> defenderWins = findWinningCells(board, defender);
+    if (defenderWins.size() > 1) return false;
+
+    std::vector<int> candidates = findThreatMoves(board, attacker);
+    for (int cell : candidates) {
+        if (!defenderWins.empty() && cell != defenderWins[0]) continue;
+
+        int row = cell / boardSize;
+        int col = cell % boardSize;
+        board.makeMove(row, col, attacker);
+
+        std::vector<int> threats = findWinningCells(board, attacker);
+        bool won = false;
+
+        if (threats.size() >= 2) {
+            // Double threat: the defender can only block one of them
+            won = true;
+        } else if (threats.size() == 1) {
+            // Single threat: the defender's reply is forced
+            int blockRow = threats[0] / boardSize;
+            int blockCol = threats[0] % boardSize;
+            board.makeMove(blockRow, blockCol, defender);
+
+            int reply = -1;
+            won = search(board, attacker, defender, depth - 1, reply);
+
+            board.undoMove(blockRow, blockCol);
+        }
+
+        board.undoMove(row, col);
+
+        if (won) {
+            move = cell;
+            return true;
+        }
+        if (timedOut) break;
+    }
+
+    return false;
+}
+
+void ThreatSearch::buildLines(int size, int winCondition) {
+    lines.clear();
+
+    const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) {
+            for (const auto& dir : directions) {
+                int endRow = row + dir[0] * (winCondition - 1);
+                int endCol = col + dir[1] * (winCondition - 1);
+                if (endRow < 0 || endRow >= size || endCol < 0 || endCol >= size) continue;
+
+                std::vector<int> line;
+                for (int i = 0; i < winCondition; i++) {
+                    line.push_back((row + dir[0] * i) * size + (col + dir[1] * i));
+                }
+                lines.push_back(line);
+            }
+        }
+    }
+}
+
+std::vector<int> ThreatSearch::findWinningCells(const Board& board, CellState player) const {
+    std::vector<int> cells;
+
+    for (const auto& line : lines) {
+        int own = 0;
+        int emptyCell = -1;
+        bool blocked = false;
+
+        for (int cell : line) {
+            CellState state = board.getCell(cell / boardSize, cell % boardSize);
+            if (state == player) {
+                own++;
+            } else if (state == EMPTY) {
+                if (emptyCell != -1) {
+                    blocked = true; // More than one empty cell
+                    break;
+                }
+                emptyCell = cell;
+            } else {
+                blocked = true;
+                break;
+            }
+        }
+
+        if (!blocked && emptyCell != -1 && own == (int)line.size() - 1 &&
+            std::find(cells.begin(), cells.end(), emptyCell) == cells.end()) {
+            cells.push_back(emptyCell);
+        }
+    }
+
+    return cells;
+}
+
+std::vector<int> ThreatSearch::findThreatMoves(const Board& board, CellState player) const {
+    // A move is a threat if it leaves a line one piece short of winning,
+    // i.e. it is one of the two empty cells of an otherwise owned line
+    std::vector<int> lineCount(boardSize * boardSize, 0);
+
+    for (const auto& line : lines) {
+        int own = 0;
+        int empties = 0;
+        int emptyCells[2] = {-1, -1};
+
+        for (int cell : line) {
+            CellState state = board.getCell(cell / boardSize, cell % boardSize);
+            if (state == player) {
+                own++;
+            } else if (state == EMPTY) {
+                if (empties < 2) emptyCells[empties] = cell;
+                empties++;
+            } else {
+                empties = -1; // Line contains an opponent piece
+                break;
+            }
+        }
+
+        if (empties == 2 && own == (int)line.size() - 2) {
+            lineCount[emptyCells[0]]++;
+            lineCount[emptyCells[1]]++;
+        }
+    }
+
+    // Try cells that create threats on several lines first
+    std::vector<int> moves;
+    for (int cell = 0; cell < (int)lineCount.size(); cell++) {
+        if (lineCount[cell] > 0) moves.push_back(cell);
+    }
+    std::stable_sort(moves.begin(), moves.end(), [&lineCount](int a, int b) {
+        return lineCount[a] > lineCount[b];
+    });
+
+    return moves;
+}
+
+bool ThreatSearch::isTimeUp() {
+    // Only poll the clock every few hundred nodes
+    if (!timedOut && (nodesSearched & 255) == 0 && std::chrono::steady_clock::now() >= deadline) {
+        timedOut = true;
+    }
+    return timedOut;
+}
\ No newline at end of file
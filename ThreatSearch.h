@@ -0,0 +1,41 @@
+#ifndef THREATSEARCH_H
+#define THREATSEARCH_H
+
+#include "Board.h"
+#include <chrono>
+#include <utility>
+#include <vector>
+
+// Threat search settings
+const int THREAT_SEARCH_TIME_MS = 50;    // Time slice taken before the main search
+const int THREAT_SEARCH_MAX_DEPTH = 12;  // Maximum number of attacker threats in a sequence
+const int THREAT_SEARCH_MIN_WIN_CONDITION = 4;
+
+// Searches only forcing moves: every attacker move must create a threat
+// to win on the next move, so the defender's reply is forced. Because the
+// tree is so narrow it finds forced wins far deeper than full-width minimax.
+class ThreatSearch {
+public:
+    ThreatSearch();
+
+    // Returns the first move of a forced win for the attacker, or {-1, -1}
+    std::pair<int, int> findForcedWin(const Board& board, CellState attacker, int timeLimitMs,
+                                      int maxDepth = THREAT_SEARCH_MAX_DEPTH);
+
+    int getNodesSearched() const;
+
+private:
+    std::vector<std::vector<int>> lines; // Cell indices of every winnable line
+    int boardSize;
+    int nodesSearched;
+    bool timedOut;
+    std::chrono::steady_clock::time_point deadline;
+
+    bool search(Board& board, CellState attacker, CellState defender, int depth, int& firstMove);
+    void buildLines(int size, int winCondition);
+    std::vector<int> findWinningCells(const Board& board, CellState player) const;
+    std::vector<int> findThreatMoves(const Board& board, CellState player) const;
+    bool isTimeUp();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "Tween.h"
+
+float applyEasing(Easing easing, float t) {
+    switch (easing) {
+        case EASE_IN_OUT_QUAD:
+            return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+        case EASE_OUT_BOUNCE:
+            if (t < 1.0f / 2.75f) {
+                return 7.5625f * t * t;
+            } else if (t < 2.0f / 2.75f) {
+                t -= 1.5f / 2.75f;
+                return 7.5625f * t * t + 0.75f;
+            } else if (t < 2.5f / 2.75f) {
+                t -= 2.25f / 2.75f;
+                return 7.5625f * t * t + 0.9375f;
+            } else {
+                t -= 2.625f / 2.75f;
+                return 7.5625f * t * t + 0.984375f;
+            }
+        case EASE_LINEAR:
+        default:
+            return t;
+    }
+}
+
+Tween::Tween() : from(0.0f), to(0.0f), elapsed(0.0f), duration(0.0f), easing(EASE_LINEAR) {}
+
+void Tween::start(float startValue, float endValue, float durationMs, Easing easingFunction) {
+    from = startValue;
+    to = endValue;
+    elapsed = 0.0f;
+    duration = durationMs;
+    easing = easingFunction;
+}
+
+void Tween::advance(float deltaMs) {
+    elapsed += deltaMs;
+    if (elapsed > duration) elapsed = duration;
+}
+
+float Tween::getProgress() const {
+    return duration > 0.0f ? elapsed / duration : 1.0f;
+}
+
+float Tween::getValue() const {
+    return from + (to - from) * applyEasing(easing, getProgress());
+}
+
+bool Tween::isFinished() const {
+    return elapsed >= duration;
+}
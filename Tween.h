@@ -0,0 +1,33 @@
+#ifndef TWEEN_H
+#define TWEEN_H
+
+enum Easing {
+    EASE_LINEAR,
+    EASE_IN_OUT_QUAD,
+    EASE_OUT_BOUNCE
+};
+
+// Eased position for a linear progress t in 0..1
+float applyEasing(Easing easing, float t);
+
+// A value eased from one number to another over a duration in
+// milliseconds. Time only moves through advance(), so the owner picks the
+// clock: frame deltas in the game, a fixed step in a benchmark.
+class Tween {
+public:
+    Tween();
+
+    void start(float from, float to, float duration, Easing easing);
+    void advance(float deltaMs);
+
+    float getProgress() const;  // Linear, 0..1
+    float getValue() const;
+    bool isFinished() const;
+
+private:
+    float from, to;
+    float elapsed, duration;
+    Easing easing;
+};
+
+#endif
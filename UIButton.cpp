@@ -1,12 +1,21 @@
 #include "UIButton.h"
 #include "Constants.h"
+#include <cmath>
 
 UIButton::UIButton(int x, int y, int w, int h, const std::string& txt) 
     : rect{x, y, w, h}, text(txt), hovered(false), pressed(false), 
-      clicked(false), hoverAnimation(0.0f) {}
+      clicked(false) {}
 
-void UIButton::handleMouseMove(int mouseX, int mouseY) {
+bool UIButton::handleMouseMove(int mouseX, int mouseY) {
+    bool wasHovered = hovered;
     hovered = isPointInRect(mouseX, mouseY);
+    if (hovered == wasHovered) return false;
+    
+    // Head for the new state from wherever the last transition got to
+    float current = hoverAnimation.getValue();
+    float target = hovered ? 1.0f : 0.0f;
+    hoverAnimation.start(current, target, BUTTON_HOVER_DURATION * std::fabs(target - current), EASE_LINEAR);
+    return true;
 }
 
 void UIButton::handleMouseClick(int mouseX, int mouseY) {
@@ -42,19 +51,15 @@ std::string UIButton::getText() const {
 }
 
 float UIButton::getHoverAnimation() const {
-    return hoverAnimation;
+    return hoverAnimation.getValue();
 }
 
 void UIButton::updateAnimation(float deltaTime) {
-    const float animationSpeed = 1000.0f / BUTTON_HOVER_DURATION; // transitions per second
-    
-    if (hovered) {
-        hoverAnimation += animationSpeed * deltaTime;
-        if (hoverAnimation > 1.0f) hoverAnimation = 1.0f;
-    } else {
-        hoverAnimation -= animationSpeed * deltaTime;
-        if (hoverAnimation < 0.0f) hoverAnimation = 0.0f;
-    }
+    hoverAnimation.advance(deltaTime * 1000.0f);
+}
+
+bool UIButton::isAnimating() const {
+    return !hoverAnimation.isFinished();
 }
 
 bool UIButton::isPointInRect(int x, int y) const {
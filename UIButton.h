@@ -4,13 +4,14 @@
 #include <SDL2/SDL.h>
 
 #include <string>
+#include "Tween.h"
 
 class UIButton {
 public:
     UIButton(int x, int y, int w, int h, const std::string& text);
     
     // Event handling
-    void handleMouseMove(int mouseX, int mouseY);
+    bool handleMouseMove(int mouseX, int mouseY);  // True if the hover state changed
     void handleMouseClick(int mouseX, int mouseY);
     bool isClicked() const;
     void resetClick();
@@ -26,6 +27,7 @@ public:
     
     // Animation update
     void updateAnimation(float deltaTime);
+    bool isAnimating() const;  // Hover transition still running
     
 private:
     SDL_Rect rect;
@@ -33,7 +35,7 @@ private:
     bool hovered;
     bool pressed;
     bool clicked;
-    float hoverAnimation;  // 0.0 to 1.0 for smooth hover transitions
+    Tween hoverAnimation;  // 0.0 to 1.0 for smooth hover transitions
     
     bool isPointInRect(int x, int y) const;
 };
@@ -0,0 +1,326 @@
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Board.h"
+#include "AI.h"
+#include "BoundedQueue.h"
+
+// Streaming batch position analyzer. Reads one position per line from a
+// file or stdin and writes the engine's move, score and search stats for
+// each, in input order. A reader, a pool of search workers and a writer are
+// connected by bounded queues, so arbitrarily large inputs are processed
+// with constant memory while every core searches.
+//
+// Input line:  <cells> [winCondition]
+//   cells lists the board row by row using X, O and '.', optionally split
+//   into rows with '/'; the board size follows from the cell count and the
+//   side to move from the piece counts. Blank lines and '#' comments are
+//   skipped.
+// Output line: <lineNumber> move=<row>,<col> [score=<s>] depth=<d> nodes=<n> time=<ms>
+//          or: <lineNumber> error=<reason>
+
+// Workers drop their in-memory search results past this many entries
+const size_t ANALYZER_MAX_CACHE_ENTRIES = 1 << 20;
+
+struct AnalyzerOptions {
+    std::string inputFile;  // Empty = stdin
+    AILevel level;
+    int searchDepth;
+    int timeLimitMs;
+    int threads;
+    int queueCapacity;
+
+    AnalyzerOptions() : level(HARD), searchDepth(0), timeLimitMs(0), threads(0), queueCapacity(256) {}
+};
+
+struct AnalysisJob {
+    long long sequence;    // Position index, used to restore input order
+    long long lineNumber;
+    std::string text;
+};
+
+struct AnalysisResult {
+    long long sequence;
+    std::string output;
+    bool failed;
+    unsigned long long nodes;
+};
+
+// Positions read but not yet written. The reader waits while a full window
+// is in flight, so results finished ahead of one slow position never pile
+// up in the writer's reorder buffer beyond the window size.
+class InFlightWindow {
+public:
+    explicit InFlightWindow(long long size) : size(size), nextWritten(0) {}
+
+    // Blocks until position 'sequence' fits in the window
+    void waitForSlot(long long sequence) {
+        std::unique_lock<std::mutex> lock(mutex);
+        slotFree.wait(lock, [this, sequence] { return sequence - nextWritten < size; });
+    }
+
+    void setNextWritten(long long sequence) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            nextWritten = sequence;
+        }
+        slotFree.notify_one();
+    }
+
+private:
+    InFlightWindow(const InFlightWindow&);
+    InFlightWindow& operator=(const InFlightWindow&);
+
+    const long long size;
+    long long nextWritten;
+    std::mutex mutex;
+    std::condition_variable slotFree;
+};
+
+bool parseLevel(const std::string& name, AILevel& level) {
+    if (name == "easy") level = EASY;
+    else if (name == "medium") level = MEDIUM;
+    else if (name == "hard") level = HARD;
+    else if (name == "neural") level = NEURAL;
+    else return false;
+    return true;
+}
+
+// Builds the board described by a line; on failure error holds the reason
+bool parsePosition(const std::string& text, Board& board, CellState& toMove, std::string& error) {
+    std::istringstream stream(text);
+    std::string token;
+    std::string cells;
+    int winCondition = 0;
+
+    stream >> token;
+    for (char c : token) {
+        if (c != '/') cells += c;
+    }
+    if (stream >> winCondition) {
+        std::string extra;
+        if (stream >> extra) {
+            error = "unexpected text after win condition";
+            return false;
+        }
+    } else if (!stream.eof()) {
+        error = "win condition is not a number";
+        return false;
+    }
+
+    int size = (int)std::lround(std::sqrt((double)cells.size()));
+    if (size < 3 || size > 6 || size * size != (int)cells.size()) {
+        error = "expected 9, 16, 25 or 36 cells";
+        return false;
+    }
+    if (winCondition == 0) winCondition = getDefaultWinCondition(size);
+    if (winCondition < 3 || winCondition > size) {
+        error = "win condition out of range";
+        return false;
+    }
+
+    board.resize(size, winCondition);
+    int xCount = 0;
+    int oCount = 0;
+    for (int i = 0; i < size * size; i++) {
+        char c = cells[i];
+        if (c == 'X' || c == 'x') {
+            board.makeMove(i / size, i % size, PLAYER_X);
+            xCount++;
+        } else if (c == 'O' || c == 'o') {
+            board.makeMove(i / size, i % size, PLAYER_O);
+            oCount++;
+        } else if (c != '.' && c != '-') {
+            error = std::string("invalid cell '") + c + "'";
+            return false;
+        }
+    }
+
+    // X moves first, so equal counts mean X is to move
+    if (xCount != oCount && xCount != oCount + 1) {
+        error = "piece counts are not reachable";
+        return false;
+    }
+    if (board.checkWin().hasWinner || board.isFull()) {
+        error = "game is already over";
+        return false;
+    }
+
+    toMove = (xCount == oCount) ? PLAYER_X : PLAYER_O;
+    return true;
+}
+
+void analyzePositions(const AnalyzerOptions& options, BoundedQueue<AnalysisJob>& jobs,
+                      BoundedQueue<AnalysisResult>& results) {
+    AI ai(options.level);
+    ai.setPersistentCache(false);      // Workers must not write the shared cache files
+    ai.setOpeningBookEnabled(false);   // Book moves carry no score or search stats
+    ai.setSearchDepth(options.searchDepth);
+    ai.setTimeLimit(options.timeLimitMs);
+
+    AnalysisJob job;
+    while (jobs.pop(job)) {
+        AnalysisResult result;
+        result.sequence = job.sequence;
+        result.failed = false;
+        result.nodes = 0;
+
+        std::ostringstream out;
+        out << job.lineNumber << " ";
+
+        Board board;
+        CellState toMove = PLAYER_X;
+        std::string error;
+        if (!parsePosition(job.text, board, toMove, error)) {
+            out << "error=" << error;
+            result.failed = true;
+        } else {
+            std::pair<int, int> move = ai.getMove(board, toMove);
+            SearchStats stats = ai.getLastSearchStats();
+            result.nodes = stats.nodes;
+
+            out << "move=" << move.first << "," << move.second;
+            if (options.level == HARD) out << " score=" << stats.score;
+            out << " depth=" << stats.depth << " nodes=" << stats.nodes
+                << " time=" << std::fixed << std::setprecision(2) << stats.elapsedMs << "ms";
+
+            if (ai.getCacheEntryCount() > ANALYZER_MAX_CACHE_ENTRIES) {
+                ai.clearCache();
+            }
+        }
+
+        result.output = out.str();
+        if (!results.push(result)) break;
+    }
+}
+
+// Prints results in input order. The window bounds how many positions are
+// in flight, so the reorder buffer never holds more than its size.
+void writeResults(BoundedQueue<AnalysisResult>& results, InFlightWindow& window, long long& written,
+                  long long& failed, unsigned long long& nodes) {
+    std::map<long long, AnalysisResult> pending;
+    long long nextSequence = 0;
+
+    AnalysisResult result;
+    while (results.pop(result)) {
+        pending[result.sequence] = result;
+
+        auto it = pending.find(nextSequence);
+        while (it != pending.end()) {
+            std::cout << it->second.output << "\n";
+            if (it->second.failed) failed++;
+            nodes += it->second.nodes;
+            written++;
+
+            pending.erase(it);
+            it = pending.find(++nextSequence);
+        }
+        window.setNextWritten(nextSequence);
+    }
+    std::cout.flush();
+}
+
+void printUsage() {
+    std::cout << "Usage: analyzer [--in FILE] [--level LEVEL] [--depth D] [--time MS] [--threads T] [--queue N]\n";
+    std::cout << "  Reads one position per line (\"<cells> [win]\", e.g. \"X.O/.X./...\") from FILE or stdin\n";
+    std::cout << "  LEVEL is easy, medium, hard (default) or neural\n";
+}
+
+int main(int argc, char* argv[]) {
+    AnalyzerOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--in") options.inputFile = value;
+        else if (arg == "--depth") options.searchDepth = std::atoi(value.c_str());
+        else if (arg == "--time") options.timeLimitMs = std::atoi(value.c_str());
+        else if (arg == "--threads") options.threads = std::atoi(value.c_str());
+        else if (arg == "--queue") options.queueCapacity = std::atoi(value.c_str());
+        else if (arg == "--level" && parseLevel(value, options.level)) continue;
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::ifstream file;
+    if (!options.inputFile.empty()) {
+        file.open(options.inputFile);
+        if (!file.is_open()) {
+            std::cerr << "Cannot open " << options.inputFile << "\n";
+            return 1;
+        }
+    }
+    std::istream& input = options.inputFile.empty() ? std::cin : file;
+
+    if (options.threads <= 0) options.threads = std::max(1u, std::thread::hardware_concurrency());
+    if (options.queueCapacity <= 0) options.queueCapacity = 1;
+
+    BoundedQueue<AnalysisJob> jobs(options.queueCapacity);
+    BoundedQueue<AnalysisResult> results(options.queueCapacity);
+    InFlightWindow window(options.queueCapacity);
+
+    long long written = 0;
+    long long failed = 0;
+    unsigned long long nodes = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread writer(writeResults, std::ref(results), std::ref(window), std::ref(written), std::ref(failed),
+                       std::ref(nodes));
+    std::vector<std::thread> workers;
+    for (int i = 0; i < options.threads; i++) {
+        workers.emplace_back(analyzePositions, std::cref(options), std::ref(jobs), std::ref(results));
+    }
+
+    // The reader blocks while a full window of positions is unwritten, so
+    // input is consumed no faster than results can be written in order
+    std::string line;
+    long long lineNumber = 0;
+    long long sequence = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+
+        window.waitForSlot(sequence);
+        AnalysisJob job;
+        job.sequence = sequence++;
+        job.lineNumber = lineNumber;
+        job.text = line.substr(first);
+        if (!jobs.push(job)) break;
+    }
+
+    jobs.close();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    results.close();
+    writer.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << std::fixed << std::setprecision(2);
+    std::cerr << "Analyzed " << written << " positions (" << failed << " errors) with " << options.threads
+              << " threads in " << seconds << "s";
+    if (seconds > 0.0) {
+        std::cerr << " (" << written / seconds << " positions/sec, " << (unsigned long long)(nodes / seconds)
+                  << " nodes/sec)";
+    }
+    std::cerr << "\n";
+    return failed == 0 ? 0 : 2;
+}
@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "AI.h"
+
+// Micro-benchmarks for the Board and AI hot paths on a fixed corpus of
+// positions for every board size. Prints a table and writes the results
+// as JSON so runs before and after a change can be compared.
+
+// Count every heap allocation made while an operation runs
+static std::atomic<unsigned long long> allocationCount(0);
+
+void* operator new(std::size_t size) {
+    allocationCount++;
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+struct BenchResult {
+    std::string name;
+    int boardSize;
+    int winCondition;
+    unsigned long long iterations;
+    double nsPerOp;
+    double allocsPerOp;
+    double nodesPerSec;  // Search benchmarks only, otherwise 0
+};
+
+struct BenchOptions {
+    int positionsPerSize;
+    int minTimeMs;
+    unsigned int seed;
+    bool includeHard;
+    std::string outputFile;
+    
+    BenchOptions() : positionsPerSize(16), minTimeMs(200), seed(12345), includeHard(true), outputFile("bench_results.json") {}
+};
+
+// Keeps results observable so the optimizer cannot drop the timed calls
+static volatile long long benchSink = 0;
+
+// Deterministic non-terminal positions spread over the opening and middle game
+std::vector<Board> buildCorpus(int size, int winCondition, int count, unsigned int seed) {
+    std::vector<Board> corpus;
+    std::mt19937 gen(seed + size * 1000);
+    int cells = size * size;
+    
+    while ((int)corpus.size() < count) {
+        int plies = (int)corpus.size() * (cells / 2) / count;
+        Board board(size, winCondition);
+        CellState toMove = PLAYER_X;
+        
+        for (int ply = 0; ply < plies; ply++) {
+            auto emptyCells = board.getEmptyCells();
+            std::uniform_int_distribution<> dis(0, (int)emptyCells.size() - 1);
+            auto cell = emptyCells[dis(gen)];
+            board.makeMove(cell.first, cell.second, toMove);
+            toMove = (toMove == PLAYER_X) ? PLAYER_O : PLAYER_X;
+        }
+        
+        if (!board.checkWin().hasWinner && !board.isFull()) {
+            corpus.push_back(board);
+        }
+    }
+    
+    return corpus;
+}
+
+CellState getSideToMove(const Board& board) {
+    int size = board.getSize();
+    int pieces = size * size - (int)board.getEmptyCells().size();
+    return (pieces % 2 == 0) ? PLAYER_X : PLAYER_O;
+}
+
+// Runs op over the whole corpus until minTimeMs has elapsed (at least once).
+// op returns the number of search nodes it visited, or 0.
+template <typename Op>
+BenchResult runBench(const std::string& name, const std::vector<Board>& corpus, int minTimeMs, Op op) {
+    BenchResult result;
+    result.name = name;
+    result.boardSize = corpus[0].getSize();
+    result.winCondition = corpus[0].getWinCondition();
+    
+    unsigned long long iterations = 0;
+    unsigned long long nodes = 0;
+    unsigned long long allocsBefore = allocationCount.load();
+    auto start = std::chrono::steady_clock::now();
+    double elapsedNs = 0.0;
+    
+    do {
+        for (const auto& board : corpus) {
+            nodes += op(board);
+            iterations++;
+        }
+        elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsedNs < minTimeMs * 1e6);
+    
+    result.iterations = iterations;
+    result.nsPerOp = elapsedNs / iterations;
+    result.allocsPerOp = (double)(allocationCount.load() - allocsBefore) / iterations;
+    result.nodesPerSec = (nodes > 0) ? nodes / (elapsedNs / 1e9) : 0.0;
+    return result;
+}
+
+const char* getLevelName(AILevel level) {
+    switch (level) {
+        case EASY: return "Easy";
+        case MEDIUM: return "Medium";
+        case HARD: return "Hard";
+        case NEURAL: return "Neural";
+    }
+    return "Unknown";
+}
+
+void printResult(const BenchResult& r) {
+    std::ostringstream label;
+    label << r.name << " " << r.boardSize << "x" << r.boardSize << "/" << r.winCondition;
+    
+    std::cout << std::left << std::setw(34) << label.str() << std::right << std::fixed << std::setprecision(1);
+    std::cout << std::setw(12) << r.iterations << " ops";
+    std::cout << std::setw(16) << r.nsPerOp << " ns/op";
+    std::cout << std::setw(12) << r.allocsPerOp << " allocs/op";
+    if (r.nodesPerSec > 0) {
+        std::cout << std::setw(12) << std::setprecision(0) << r.nodesPerSec << " nodes/s";
+    }
+    std::cout << "\n";
+}
+
+bool writeJson(const std::string& filename, const BenchOptions& options, const std::vector<BenchResult>& results) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    file << "{\n";
+    file << "  \"timestamp\": " << (long long)std::time(nullptr) << ",\n";
+    file << "  \"positionsPerSize\": " << options.positionsPerSize << ",\n";
+    file << "  \"minTimeMs\": " << options.minTimeMs << ",\n";
+    file << "  \"seed\": " << options.seed << ",\n";
+    file << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        file << "    {\"name\": \"" << r.name << "\", \"boardSize\": " << r.boardSize
+             << ", \"winCondition\": " << r.winCondition << ", \"iterations\": " << r.iterations
+             << ", \"nsPerOp\": " << r.nsPerOp << ", \"allocsPerOp\": " << r.allocsPerOp
+             << ", \"nodesPerSec\": " << r.nodesPerSec << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+    return (bool)file;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--no-hard") {
+            options.includeHard = false;
+        } else if (arg == "--positions" && i + 1 < argc) {
+            options.positionsPerSize = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            options.minTimeMs = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.seed = (unsigned int)std::atoi(argv[++i]);
+        } else if (arg == "--out" && i + 1 < argc) {
+            options.outputFile = argv[++i];
+        } else {
+            std::cout << "Usage: bench [--positions N] [--min-time MS] [--seed S] [--no-hard] [--out FILE]\n";
+            return 1;
+        }
+    }
+    
+    std::vector<BenchResult> results;
+    auto record = [&results](const BenchResult& result) {
+        printResult(result);
+        results.push_back(result);
+    };
+    
+    for (int size = 3; size <= 6; size++) {
+        int winCondition = getDefaultWinCondition(size);
+        std::vector<Board> corpus = buildCorpus(size, winCondition, options.positionsPerSize, options.seed);
+        
+        record(runBench("Board::checkWin", corpus, options.minTimeMs, [](const Board& board) {
+            benchSink += board.checkWin().hasWinner;
+            return 0ULL;
+        }));
+        record(runBench("Board::getEmptyCells", corpus, options.minTimeMs, [](const Board& board) {
+            benchSink += (long long)board.getEmptyCells().size();
+            return 0ULL;
+        }));
+        record(runBench("Board::isFull", corpus, options.minTimeMs, [](const Board& board) {
+            benchSink += board.isFull();
+            return 0ULL;
+        }));
+        
+        AI helper;
+        record(runBench("AI::findWinningMove", corpus, options.minTimeMs, [&helper](const Board& board) {
+            benchSink += helper.findWinningMove(board, getSideToMove(board)).first;
+            return 0ULL;
+        }));
+        
+        AILevel levels[] = {EASY, MEDIUM, HARD, NEURAL};
+        for (AILevel level : levels) {
+            if (level == HARD && !options.includeHard) continue;
+            
+            // One engine per level, set up and warmed (Neural loads its
+            // weights) before timing starts. Book and disk cache are off to
+            // time the search.
+            AI ai(level);
+            ai.setSeed(1);
+            ai.setOpeningBookEnabled(false);
+            ai.setPersistentCache(false);
+            benchSink += ai.getMove(corpus[0], getSideToMove(corpus[0])).first;
+            
+            // Hard would answer repeated positions from its in-memory cache,
+            // so every call starts from an empty one
+            if (level == HARD) {
+                record(runBench("AI::getMove(Hard, cold cache)", corpus, 0, [&ai](const Board& board) {
+                    ai.clearCache();
+                    benchSink += ai.getMove(board, getSideToMove(board)).first;
+                    return ai.getLastSearchStats().nodes;
+                }));
+                continue;
+            }
+            
+            std::string name = std::string("AI::getMove(") + getLevelName(level) + ")";
+            record(runBench(name, corpus, options.minTimeMs, [&ai](const Board& board) {
+                benchSink += ai.getMove(board, getSideToMove(board)).first;
+                return ai.getLastSearchStats().nodes;
+            }));
+        }
+    }
+    
+    if (!writeJson(options.outputFile, options, results)) {
+        std::cerr << "Failed to write " << options.outputFile << "\n";
+        return 1;
+    }
+    std::cout << "Results written to " << options.outputFile << "\n";
+    return 0;
+}
\ No newline at end of file
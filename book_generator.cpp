@@ -0,0 +1,143 @@
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+#include "Board.h"
+#include "AI.h"
+#include "OpeningBook.h"
+
+// Builds book_<N>x<N>_<win>.bin from deep offline searches. For each side,
+// the book side only follows its best moves while every opponent reply is
+// expanded, so the book covers all openings the AI can actually reach.
+class BookGenerator {
+private:
+    AI ai;
+    int boardSize;
+    int winCondition;
+    int plies;
+    std::map<uint64_t, std::vector<BookMove>> positions;
+    std::set<uint64_t> visited;
+    int searches;
+
+public:
+    BookGenerator(int size, int winCond, int bookPlies, int depth)
+        : ai(HARD), boardSize(size), winCondition(winCond), plies(bookPlies), searches(0) {
+        ai.setSearchDepth(depth);
+        ai.setOpeningBookEnabled(false); // Never read the book being rebuilt
+        ai.setPersistentCache(false);
+    }
+
+    void generate() {
+        CellState sides[] = {PLAYER_X, PLAYER_O};
+        for (CellState bookSide : sides) {
+            visited.clear();
+            Board board(boardSize, winCondition);
+            expand(board, PLAYER_X, bookSide, 0);
+        }
+    }
+
+    const std::map<uint64_t, std::vector<BookMove>>& getPositions() const {
+        return positions;
+    }
+
+private:
+    void expand(Board& board, CellState toMove, CellState bookSide, int ply) {
+        if (ply >= plies || board.checkWin().hasWinner || board.isFull()) return;
+        
+        int symmetry = 0;
+        uint64_t key = OpeningBook::canonicalKey(board, toMove, symmetry);
+        if (!visited.insert(key).second) return;
+        
+        CellState next = (toMove == PLAYER_X) ? PLAYER_O : PLAYER_X;
+        std::vector<std::pair<int, int>> children;
+        
+        if (toMove == bookSide) {
+            // Book all moves that share the best score
+            auto analysis = ai.analyze(board, toMove);
+            searches++;
+            
+            int bestScore = analysis.empty() ? 0 : analysis[0].score;
+            for (const auto& move : analysis) {
+                if (move.score > bestScore) bestScore = move.score;
+            }
+            
+            std::vector<BookMove>& bookMoves = positions[key];
+            for (const auto& move : analysis) {
+                if (move.score != bestScore) continue;
+                
+                BookMove bookMove;
+                bookMove.cell = (uint8_t)OpeningBook::transformCell(move.row * boardSize + move.col, boardSize, symmetry);
+                bookMove.reserved = 0;
+                bookMove.weight = 1;
+                bookMoves.push_back(bookMove);
+                children.push_back({move.row, move.col});
+            }
+            
+            if (searches % 100 == 0) {
+                std::cout << "  " << searches << " positions searched...\n";
+            }
+        } else {
+            children = board.getEmptyCells();
+        }
+        
+        for (const auto& cell : children) {
+            board.makeMove(cell.first, cell.second, toMove);
+            expand(board, next, bookSide, ply + 1);
+            board.undoMove(cell.first, cell.second);
+        }
+    }
+};
+
+int main(int argc, char* argv[]) {
+    int size = 3;
+    int winCondition = 0;
+    int plies = 4;
+    int depth = 0;
+    std::string output;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--size" && i + 1 < argc) {
+            size = std::atoi(argv[++i]);
+        } else if (arg == "--win" && i + 1 < argc) {
+            winCondition = std::atoi(argv[++i]);
+        } else if (arg == "--plies" && i + 1 < argc) {
+            plies = std::atoi(argv[++i]);
+        } else if (arg == "--depth" && i + 1 < argc) {
+            depth = std::atoi(argv[++i]);
+        } else if (arg == "--out" && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            std::cout << "Usage: book_generator [--size N] [--win W] [--plies P] [--depth D] [--out FILE]\n";
+            std::cout << "  --depth defaults to one ply deeper than Hard mode plays\n";
+            return 1;
+        }
+    }
+
+    if (size < 3 || size > 6) {
+        std::cerr << "Board size must be between 3 and 6\n";
+        return 1;
+    }
+    if (winCondition <= 0) winCondition = getDefaultWinCondition(size);
+    if (output.empty()) output = OpeningBook::getFileName(size, winCondition);
+    if (depth <= 0) depth = AI::getDefaultSearchDepth(size) + 1;
+
+    std::cout << "Generating " << size << "x" << size << " book (" << winCondition << " in a row), "
+              << plies << " plies at depth " << depth << "\n";
+
+    std::clock_t start = std::clock();
+    BookGenerator generator(size, winCondition, plies, depth);
+    generator.generate();
+
+    if (!OpeningBook::write(output, size, winCondition, plies, generator.getPositions())) {
+        std::cerr << "Failed to write " << output << "\n";
+        return 1;
+    }
+
+    double seconds = (double)(std::clock() - start) / CLOCKS_PER_SEC;
+    std::cout << "Wrote " << generator.getPositions().size() << " positions to " << output
+              << " in " << seconds << "s\n";
+    return 0;
+}
\ No newline at end of file
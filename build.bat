@@ -4,9 +4,12 @@ echo Building SDL2 Tic Tac Toe Game...
 REM Add MSYS2 MinGW64 to PATH
 set PATH=C:\msys64\mingw64\bin;%PATH%
 
+REM Board and AI sources shared by every target
+set CORE_SOURCES=Board.cpp AI.cpp ThreatSearch.cpp PositionCache.cpp MappedFile.cpp OpeningBook.cpp NeuralNet.cpp LatencyHistogram.cpp GameLog.cpp HistoryStore.cpp
+
 REM Compile the main SDL2 version
 echo Compiling SDL2 version...
-g++ -o TicTacToe main.cpp Game.cpp Board.cpp Renderer.cpp AI.cpp AudioManager.cpp UIButton.cpp ScoreTracker.cpp -lmingw32 -lSDL2main -lSDL2 -lSDL2_ttf -lSDL2_mixer -std=c++11
+g++ -o TicTacToe main.cpp Game.cpp Renderer.cpp TextTextureCache.cpp GlyphAtlas.cpp RenderBatch.cpp Tween.cpp FrameProfiler.cpp AudioManager.cpp UIButton.cpp ScoreTracker.cpp %CORE_SOURCES% -lmingw32 -lSDL2main -lSDL2 -lSDL2_ttf -lSDL2_mixer -pthread -std=c++11
 
 if %ERRORLEVEL% EQU 0 (
     echo SDL2 version compiled successfully!
@@ -17,16 +20,103 @@ if %ERRORLEVEL% EQU 0 (
 
 REM Compile the console version
 echo Compiling console version...
-g++ -o console_tictactoe console_main.cpp Board.cpp AI.cpp ScoreTracker.cpp -std=c++11
+g++ -o console_tictactoe console_main.cpp %CORE_SOURCES% ScoreTracker.cpp -pthread -std=c++11
 
 if %ERRORLEVEL% EQU 0 (
     echo Console version compiled successfully!
+) else (
+    echo Failed to compile console version!
+    goto :end
+)
+
+REM Compile the opening book generator
+echo Compiling opening book generator...
+g++ -o book_generator book_generator.cpp %CORE_SOURCES% -O2 -std=c++11
+
+if %ERRORLEVEL% EQU 0 (
+    echo Opening book generator compiled successfully!
+) else (
+    echo Failed to compile opening book generator!
+    goto :end
+)
+
+REM Compile the neural network trainer
+echo Compiling neural network trainer...
+g++ -o neural_trainer neural_trainer.cpp %CORE_SOURCES% -O2 -std=c++11
+
+if %ERRORLEVEL% EQU 0 (
+    echo Neural network trainer compiled successfully!
+) else (
+    echo Failed to compile neural network trainer!
+    goto :end
+)
+
+REM Compile the micro-benchmark suite
+echo Compiling benchmark suite...
+g++ -o bench bench.cpp %CORE_SOURCES% -O2 -std=c++11
+
+if %ERRORLEVEL% EQU 0 (
+    echo Benchmark suite compiled successfully!
+) else (
+    echo Failed to compile benchmark suite!
+    goto :end
+)
+
+REM Compile the perft move-count checker
+echo Compiling perft checker...
+g++ -o perft perft.cpp Board.cpp -O2 -std=c++11
+
+if %ERRORLEVEL% EQU 0 (
+    echo Perft checker compiled successfully!
+) else (
+    echo Failed to compile perft checker!
+    goto :end
+)
+
+REM Compile the batch position analyzer
+echo Compiling position analyzer...
+g++ -o analyzer analyzer.cpp %CORE_SOURCES% -O2 -pthread -std=c++11
+
+if %ERRORLEVEL% EQU 0 (
+    echo Position analyzer compiled successfully!
+) else (
+    echo Failed to compile position analyzer!
+    goto :end
+)
+
+REM Compile the game log reader
+echo Compiling game log tool...
+g++ -o game_log_tool game_log_tool.cpp Board.cpp GameLog.cpp MappedFile.cpp -O2 -std=c++11
+
+if %ERRORLEVEL% EQU 0 (
+    echo Game log tool compiled successfully!
+) else (
+    echo Failed to compile game log tool!
+    goto :end
+)
+
+REM game_server and load_client use epoll and build on Linux only
+REM (build.ps1 under PowerShell on Linux, or the commands in README.md)
+
+REM Compile the headless self-play tournament runner
+echo Compiling tournament runner...
+g++ -o tournament tournament.cpp %CORE_SOURCES% ScoreTracker.cpp -O2 -pthread -std=c++11
+
+if %ERRORLEVEL% EQU 0 (
+    echo Tournament runner compiled successfully!
     echo.
     echo Build completed successfully!
     echo Run TicTacToe.exe for the SDL2 GUI version
-    echo Run console_tictactoe.exe for the console version
+    echo Run console_tictactoe.exe for the console version (--engine for the engine protocol)
+    echo Run book_generator.exe to build opening books
+    echo Run neural_trainer.exe to regenerate the Neural AI weights
+    echo Run tournament.exe to measure AI strength with self-play
+    echo Run bench.exe to time the Board and AI hot paths
+    echo Run perft.exe to validate move generation and win detection
+    echo Run analyzer.exe to analyze positions in bulk
+    echo Run game_log_tool.exe to inspect game_log.bin
 ) else (
-    echo Failed to compile console version!
+    echo Failed to compile tournament runner!
 )
 
 :end
@@ -5,9 +5,12 @@ Write-Host "Building SDL2 Tic Tac Toe Game..." -ForegroundColor Green
 # Add MSYS2 MinGW64 to PATH
 $env:PATH = "C:\msys64\mingw64\bin;" + $env:PATH
 
+# Board and AI sources shared by every target
+$coreSources = @("Board.cpp", "AI.cpp", "ThreatSearch.cpp", "PositionCache.cpp", "MappedFile.cpp", "OpeningBook.cpp", "NeuralNet.cpp", "LatencyHistogram.cpp", "GameLog.cpp", "HistoryStore.cpp")
+
 # Compile the main SDL2 version
 Write-Host "Compiling SDL2 version..." -ForegroundColor Yellow
-$result = & g++ -o TicTacToe main.cpp Game.cpp Board.cpp Renderer.cpp AI.cpp AudioManager.cpp UIButton.cpp ScoreTracker.cpp -lmingw32 -lSDL2main -lSDL2 -lSDL2_ttf -lSDL2_mixer -std=c++11 2>&1
+$result = & g++ -o TicTacToe main.cpp Game.cpp Renderer.cpp TextTextureCache.cpp GlyphAtlas.cpp RenderBatch.cpp Tween.cpp FrameProfiler.cpp AudioManager.cpp UIButton.cpp ScoreTracker.cpp $coreSources -lmingw32 -lSDL2main -lSDL2 -lSDL2_ttf -lSDL2_mixer -pthread -std=c++11 2>&1
 
 if ($LASTEXITCODE -eq 0) {
     Write-Host "SDL2 version compiled successfully!" -ForegroundColor Green
@@ -19,16 +22,126 @@ if ($LASTEXITCODE -eq 0) {
 
 # Compile the console version
 Write-Host "Compiling console version..." -ForegroundColor Yellow
-$result = & g++ -o console_tictactoe console_main.cpp Board.cpp AI.cpp ScoreTracker.cpp -std=c++11 2>&1
+$result = & g++ -o console_tictactoe console_main.cpp $coreSources ScoreTracker.cpp -pthread -std=c++11 2>&1
 
 if ($LASTEXITCODE -eq 0) {
     Write-Host "Console version compiled successfully!" -ForegroundColor Green
+} else {
+    Write-Host "Failed to compile console version!" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    exit 1
+}
+
+# Compile the opening book generator
+Write-Host "Compiling opening book generator..." -ForegroundColor Yellow
+$result = & g++ -o book_generator book_generator.cpp $coreSources -O2 -std=c++11 2>&1
+
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "Opening book generator compiled successfully!" -ForegroundColor Green
+} else {
+    Write-Host "Failed to compile opening book generator!" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    exit 1
+}
+
+# Compile the neural network trainer
+Write-Host "Compiling neural network trainer..." -ForegroundColor Yellow
+$result = & g++ -o neural_trainer neural_trainer.cpp $coreSources -O2 -std=c++11 2>&1
+
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "Neural network trainer compiled successfully!" -ForegroundColor Green
+} else {
+    Write-Host "Failed to compile neural network trainer!" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    exit 1
+}
+
+# Compile the micro-benchmark suite
+Write-Host "Compiling benchmark suite..." -ForegroundColor Yellow
+$result = & g++ -o bench bench.cpp $coreSources -O2 -std=c++11 2>&1
+
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "Benchmark suite compiled successfully!" -ForegroundColor Green
+} else {
+    Write-Host "Failed to compile benchmark suite!" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    exit 1
+}
+
+# Compile the perft move-count checker
+Write-Host "Compiling perft checker..." -ForegroundColor Yellow
+$result = & g++ -o perft perft.cpp Board.cpp -O2 -std=c++11 2>&1
+
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "Perft checker compiled successfully!" -ForegroundColor Green
+} else {
+    Write-Host "Failed to compile perft checker!" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    exit 1
+}
+
+# Compile the batch position analyzer
+Write-Host "Compiling position analyzer..." -ForegroundColor Yellow
+$result = & g++ -o analyzer analyzer.cpp $coreSources -O2 -pthread -std=c++11 2>&1
+
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "Position analyzer compiled successfully!" -ForegroundColor Green
+} else {
+    Write-Host "Failed to compile position analyzer!" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    exit 1
+}
+
+# Compile the game log reader
+Write-Host "Compiling game log tool..." -ForegroundColor Yellow
+$result = & g++ -o game_log_tool game_log_tool.cpp Board.cpp GameLog.cpp MappedFile.cpp -O2 -std=c++11 2>&1
+
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "Game log tool compiled successfully!" -ForegroundColor Green
+} else {
+    Write-Host "Failed to compile game log tool!" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    exit 1
+}
+
+# Compile the game server and its load client (epoll, so Linux only)
+if ($IsLinux) {
+    Write-Host "Compiling game server and load client..." -ForegroundColor Yellow
+    $result = & g++ -o game_server game_server.cpp $coreSources -O2 -pthread -std=c++11 2>&1
+    if ($LASTEXITCODE -eq 0) {
+        $result = & g++ -o load_client load_client.cpp Board.cpp -O2 -std=c++11 2>&1
+    }
+
+    if ($LASTEXITCODE -eq 0) {
+        Write-Host "Game server and load client compiled successfully!" -ForegroundColor Green
+    } else {
+        Write-Host "Failed to compile game server or load client!" -ForegroundColor Red
+        Write-Host $result -ForegroundColor Red
+        exit 1
+    }
+} else {
+    Write-Host "Skipping game server and load client (they use epoll and build on Linux only)" -ForegroundColor Yellow
+}
+
+# Compile the headless self-play tournament runner
+Write-Host "Compiling tournament runner..." -ForegroundColor Yellow
+$result = & g++ -o tournament tournament.cpp $coreSources ScoreTracker.cpp -O2 -pthread -std=c++11 2>&1
+
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "Tournament runner compiled successfully!" -ForegroundColor Green
     Write-Host ""
     Write-Host "Build completed successfully!" -ForegroundColor Green
     Write-Host "Run TicTacToe.exe for the SDL2 GUI version" -ForegroundColor Cyan
-    Write-Host "Run console_tictactoe.exe for the console version" -ForegroundColor Cyan
+    Write-Host "Run console_tictactoe.exe for the console version (--engine for the engine protocol)" -ForegroundColor Cyan
+    Write-Host "Run book_generator.exe to build opening books" -ForegroundColor Cyan
+    Write-Host "Run neural_trainer.exe to regenerate the Neural AI weights" -ForegroundColor Cyan
+    Write-Host "Run tournament.exe to measure AI strength with self-play" -ForegroundColor Cyan
+    Write-Host "Run bench.exe to time the Board and AI hot paths" -ForegroundColor Cyan
+    Write-Host "Run perft.exe to validate move generation and win detection" -ForegroundColor Cyan
+    Write-Host "Run analyzer.exe to analyze positions in bulk" -ForegroundColor Cyan
+    Write-Host "Run game_log_tool.exe to inspect game_log.bin" -ForegroundColor Cyan
 } else {
-    Write-Host "Failed to compile console version!" -ForegroundColor Red
+    Write-Host "Failed to compile tournament runner!" -ForegroundColor Red
     Write-Host $result -ForegroundColor Red
     exit 1
 }
\ No newline at end of file
@@ -1,5 +1,10 @@
+#include <atomic>
 #include <iostream>
 #include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
 #include "Board.h"
 #include "AI.h"
 
@@ -114,11 +119,227 @@ public:
             }
         }
 
+        ai.saveCache();
         std::cout << "\nThanks for playing!\n";
     }
 };
 
-int main() {
+// Line-based engine protocol (UCI-style) for driving the AI from external
+// programs. Commands, one per line on stdin:
+//   size <N> [win]                      new empty board (default win by size)
+//   position startpos [moves r,c ...]   empty board plus moves, X first
+//   position <cells> [moves r,c ...]    cells row by row as X, O and '.'
+//   level easy|medium|hard|neural
+//   go [depth D] [movetime MS] [infinite]
+//   stop | isready | newgame | quit
+// Searches run on a background thread; while one runs, "info" lines report
+// each completed depth, then "bestmove r,c" ends it. stop answers at once
+// with the best move of the deepest completed iteration.
+class EngineSession {
+private:
+    Board board;
+    AI ai;
+    CellState toMove;
+    std::thread searchThread;
+    std::atomic<bool> stopRequested;
+    std::mutex outputMutex;
+
+    void send(const std::string& line) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::cout << line << std::endl;
+    }
+
+    static CellState getOpponent(CellState player) {
+        return (player == PLAYER_X) ? PLAYER_O : PLAYER_X;
+    }
+
+    // Stop any running search and wait for its bestmove
+    void finishSearch() {
+        if (searchThread.joinable()) {
+            stopRequested = true;
+            searchThread.join();
+        }
+    }
+
+    void handleSize(std::istringstream& args) {
+        int size = 0;
+        int winCondition = 0;
+        args >> size >> winCondition;
+        if (size < 3 || size > 6) {
+            send("info string error size must be between 3 and 6");
+            return;
+        }
+        if (winCondition <= 0) winCondition = getDefaultWinCondition(size);
+        if (winCondition < 3 || winCondition > size) {
+            send("info string error win condition out of range");
+            return;
+        }
+
+        board.resize(size, winCondition);
+        toMove = PLAYER_X;
+    }
+
+    void handlePosition(std::istringstream& args) {
+        std::string token;
+        if (!(args >> token)) {
+            send("info string error missing position");
+            return;
+        }
+
+        int size = board.getSize();
+        Board newBoard(size, board.getWinCondition());
+        CellState side = PLAYER_X;
+
+        if (token != "startpos") {
+            if ((int)token.size() != size * size) {
+                send("info string error position needs " + std::to_string(size * size) + " cells");
+                return;
+            }
+            int xCount = 0;
+            int oCount = 0;
+            for (int i = 0; i < size * size; i++) {
+                if (token[i] == 'X' || token[i] == 'x') {
+                    newBoard.makeMove(i / size, i % size, PLAYER_X);
+                    xCount++;
+                } else if (token[i] == 'O' || token[i] == 'o') {
+                    newBoard.makeMove(i / size, i % size, PLAYER_O);
+                    oCount++;
+                }
+            }
+            if (xCount != oCount && xCount != oCount + 1) {
+                send("info string error piece counts are not reachable");
+                return;
+            }
+            side = (xCount == oCount) ? PLAYER_X : PLAYER_O;
+        }
+
+        if (args >> token && token == "moves") {
+            while (args >> token) {
+                int row = -1;
+                int col = -1;
+                char comma = 0;
+                std::istringstream move(token);
+                if (!(move >> row >> comma >> col) || comma != ',' || !newBoard.makeMove(row, col, side)) {
+                    send("info string error illegal move " + token);
+                    return;
+                }
+                side = getOpponent(side);
+            }
+        }
+
+        board = newBoard;
+        toMove = side;
+    }
+
+    void handleLevel(std::istringstream& args) {
+        std::string name;
+        args >> name;
+        if (name == "easy") ai.setLevel(EASY);
+        else if (name == "medium") ai.setLevel(MEDIUM);
+        else if (name == "hard") ai.setLevel(HARD);
+        else if (name == "neural") ai.setLevel(NEURAL);
+        else send("info string error unknown level " + name);
+    }
+
+    void handleGo(std::istringstream& args) {
+        int depth = 0;
+        int moveTime = 0;
+        std::string token;
+        while (args >> token) {
+            if (token == "depth") args >> depth;
+            else if (token == "movetime") args >> moveTime;
+            else if (token == "infinite") depth = (int)board.getEmptyCells().size();
+        }
+
+        if (board.checkWin().hasWinner || board.isFull()) {
+            send("bestmove none");
+            return;
+        }
+
+        ai.setSearchDepth(depth);
+        ai.setTimeLimit(moveTime);
+        stopRequested = false;
+
+        Board searchBoard = board;
+        CellState side = toMove;
+        searchThread = std::thread([this, searchBoard, side]() {
+            std::pair<int, int> move = ai.getMove(searchBoard, side);
+            SearchStats stats = ai.getLastSearchStats();
+
+            std::ostringstream line;
+            line << "info string nodes " << stats.nodes << " time " << (long long)stats.elapsedMs;
+            send(line.str());
+            send("bestmove " + std::to_string(move.first) + "," + std::to_string(move.second));
+        });
+    }
+
+    void sendProgress(const SearchStats& stats, const MoveAnalysis& best) {
+        std::ostringstream line;
+        long long nodesPerSec = (stats.elapsedMs > 0.0) ? (long long)(stats.nodes * 1000.0 / stats.elapsedMs) : 0;
+        line << "info depth " << stats.depth << " score " << stats.score << " nodes " << stats.nodes
+             << " nps " << nodesPerSec << " time " << (long long)stats.elapsedMs << " pv";
+        for (const auto& move : best.principalVariation) {
+            line << " " << move.first << "," << move.second;
+        }
+        send(line.str());
+    }
+
+public:
+    EngineSession() : toMove(PLAYER_X), stopRequested(false) {
+        ai.setLevel(HARD);
+        ai.setStopFlag(&stopRequested);
+        ai.setProgressCallback([this](const SearchStats& stats, const MoveAnalysis& best) {
+            sendProgress(stats, best);
+        });
+    }
+
+    void run() {
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            std::istringstream args(line);
+            std::string command;
+            if (!(args >> command)) continue;
+
+            if (command == "quit") {
+                break;
+            } else if (command == "isready") {
+                send("readyok");
+            } else if (command == "stop") {
+                finishSearch();
+            } else if (command == "go") {
+                finishSearch();
+                handleGo(args);
+            } else if (command == "size") {
+                finishSearch();
+                handleSize(args);
+            } else if (command == "position") {
+                finishSearch();
+                handlePosition(args);
+            } else if (command == "level") {
+                finishSearch();
+                handleLevel(args);
+            } else if (command == "newgame") {
+                finishSearch();
+                ai.saveCache();  // Results are keyed by position and stay valid across games
+                board.reset();
+                toMove = PLAYER_X;
+            } else {
+                send("info string error unknown command " + command);
+            }
+        }
+
+        finishSearch();
+        ai.saveCache();
+    }
+};
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--engine") {
+        EngineSession session;
+        session.run();
+        return 0;
+    }
+
     ConsoleGame game;
     game.run();
     return 0;
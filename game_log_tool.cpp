@@ -0,0 +1,224 @@
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include "Board.h"
+#include "GameLog.h"
+
+// Reads the binary game log written by the game (game_log.bin): summary
+// statistics, a replay of individual games, and a generator of synthetic
+// logs for measuring read throughput.
+struct LogToolOptions {
+    std::string command;
+    std::string filename;
+    int limit;
+    int games;
+    unsigned int seed;
+
+    LogToolOptions() : filename(GAME_LOG_FILE), limit(10), games(1000000), seed(1) {}
+};
+
+const char* getWinnerText(CellState winner) {
+    switch (winner) {
+        case PLAYER_X: return "X wins";
+        case PLAYER_O: return "O wins";
+        default: return "draw";
+    }
+}
+
+int printStats(const LogToolOptions& options) {
+    GameLogReader reader;
+    if (!reader.open(options.filename)) {
+        std::cerr << "Cannot open game log " << options.filename << "\n";
+        return 1;
+    }
+
+    // Indexed by board size
+    long long games[7] = {0};
+    long long xWins[7] = {0};
+    long long oWins[7] = {0};
+    long long moves[7] = {0};
+    long long aiMoves[7] = {0};
+    double aiTimeUs[7] = {0};
+
+    auto start = std::chrono::steady_clock::now();
+    GameRecord record;
+    long long total = 0;
+    while (reader.next(record)) {
+        total++;
+        int size = record.boardSize;
+        if (size < 3 || size > 6) continue;
+
+        games[size]++;
+        if (record.winner == PLAYER_X) xWins[size]++;
+        if (record.winner == PLAYER_O) oWins[size]++;
+        moves[size] += (long long)record.moves.size();
+        for (const auto& move : record.moves) {
+            if (move.aiTimeUs > 0) {
+                aiMoves[size]++;
+                aiTimeUs[size] += move.aiTimeUs;
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (int size = 3; size <= 6; size++) {
+        if (games[size] == 0) continue;
+        std::cout << size << "x" << size << ": " << games[size] << " games, X " << 100.0 * xWins[size] / games[size]
+                  << "%, O " << 100.0 * oWins[size] / games[size] << "%, draws "
+                  << 100.0 * (games[size] - xWins[size] - oWins[size]) / games[size] << "%, "
+                  << (double)moves[size] / games[size] << " moves/game";
+        if (aiMoves[size] > 0) {
+            std::cout << ", AI " << aiTimeUs[size] / aiMoves[size] / 1000.0 << " ms/move";
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "Read " << total << " games (" << reader.getOffset() << " bytes) in " << std::setprecision(3)
+              << seconds << "s";
+    if (seconds > 0.0) std::cout << " (" << std::setprecision(0) << total / seconds << " games/sec)";
+    std::cout << "\n";
+    if (reader.getOffset() < reader.getSize()) {
+        std::cout << "Ignored " << reader.getSize() - reader.getOffset() << " bytes of truncated or corrupt data\n";
+    }
+    return 0;
+}
+
+int dumpGames(const LogToolOptions& options) {
+    GameLogReader reader;
+    if (!reader.open(options.filename)) {
+        std::cerr << "Cannot open game log " << options.filename << "\n";
+        return 1;
+    }
+
+    GameRecord record;
+    for (int index = 0; index < options.limit && reader.next(record); index++) {
+        std::time_t time = (std::time_t)record.timestamp;
+        char date[32] = "";
+        std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", std::localtime(&time));
+
+        std::cout << "#" << index << "  " << record.boardSize << "x" << record.boardSize << " ("
+                  << record.winCondition << " in a row), mode " << record.mode << ", AI level " << record.aiLevel
+                  << ", " << getWinnerText(record.winner) << ", " << date << "\n  ";
+
+        // Replay the moves on a board to show the final position
+        Board board(record.boardSize, record.winCondition);
+        CellState player = PLAYER_X;
+        for (const auto& move : record.moves) {
+            int row = move.cell / record.boardSize;
+            int col = move.cell % record.boardSize;
+            board.makeMove(row, col, player);
+            player = (player == PLAYER_X) ? PLAYER_O : PLAYER_X;
+
+            std::cout << row << "," << col;
+            if (move.aiTimeUs > 0) std::cout << "(" << move.aiTimeUs / 1000.0 << "ms)";
+            std::cout << " ";
+        }
+        std::cout << "\n";
+
+        for (int row = 0; row < record.boardSize; row++) {
+            std::cout << "  ";
+            for (int col = 0; col < record.boardSize; col++) {
+                CellState cell = board.getCell(row, col);
+                std::cout << (cell == PLAYER_X ? 'X' : cell == PLAYER_O ? 'O' : '.');
+            }
+            std::cout << "\n";
+        }
+    }
+    return 0;
+}
+
+// Appends random games, for testing readers at scale
+int generateGames(const LogToolOptions& options) {
+    GameLogWriter writer;
+    if (!writer.open(options.filename)) {
+        std::cerr << "Cannot open game log " << options.filename << "\n";
+        return 1;
+    }
+
+    std::mt19937 gen(options.seed);
+    GameRecord record;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int game = 0; game < options.games; game++) {
+        int size = 3 + game % 4;
+        Board board(size, getDefaultWinCondition(size));
+        record.boardSize = size;
+        record.winCondition = board.getWinCondition();
+        record.mode = 1 + game % 3;
+        record.aiLevel = game % 3;
+        record.timestamp = (uint64_t)std::time(nullptr);
+        record.moves.clear();
+
+        CellState player = PLAYER_X;
+        while (!board.checkWin().hasWinner && !board.isFull()) {
+            auto emptyCells = board.getEmptyCells();
+            std::uniform_int_distribution<> dis(0, (int)emptyCells.size() - 1);
+            auto cell = emptyCells[dis(gen)];
+            board.makeMove(cell.first, cell.second, player);
+
+            GameLogMove move;
+            move.cell = cell.first * size + cell.second;
+            move.aiTimeUs = (player == PLAYER_O) ? (uint32_t)(gen() % 5000) : 0;
+            record.moves.push_back(move);
+            player = (player == PLAYER_X) ? PLAYER_O : PLAYER_X;
+        }
+
+        WinInfo winInfo = board.checkWin();
+        record.winner = winInfo.hasWinner ? winInfo.winner : EMPTY;
+        if (!writer.append(record)) {
+            std::cerr << "Write failed after " << game << " games\n";
+            return 1;
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Appended " << options.games << " games to " << options.filename << " in " << std::fixed
+              << std::setprecision(2) << seconds << "s\n";
+    return 0;
+}
+
+void printUsage() {
+    std::cout << "Usage: game_log_tool stats|dump|generate [--log FILE] [--limit N] [--games N] [--seed S]\n";
+    std::cout << "  stats     per-size results, game length and AI time, plus read speed\n";
+    std::cout << "  dump      replay the first --limit games\n";
+    std::cout << "  generate  append --games random games (for benchmarking readers)\n";
+}
+
+int main(int argc, char* argv[]) {
+    LogToolOptions options;
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+    options.command = argv[1];
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--log") options.filename = value;
+        else if (arg == "--limit") options.limit = std::atoi(value.c_str());
+        else if (arg == "--games") options.games = std::atoi(value.c_str());
+        else if (arg == "--seed") options.seed = (unsigned int)std::atoi(value.c_str());
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (options.command == "stats") return printStats(options);
+    if (options.command == "dump") return dumpGames(options);
+    if (options.command == "generate") return generateGames(options);
+
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,571 @@
+#include <iostream>
+
+#ifdef __linux__
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Board.h"
+#include "AI.h"
+#include "BoundedQueue.h"
+#include "ObjectPool.h"
+#include "ServerProtocol.h"
+
+// Multi-session game server. One I/O thread multiplexes every connection
+// with epoll; AI searches run on a worker pool and their results come back
+// through a completion list and an eventfd that wakes the I/O thread.
+// Sessions come from an ObjectPool, so connects and disconnects reuse
+// the same memory (buffers keep their capacity).
+namespace {
+
+const size_t SERVER_MAX_QUEUED_SEARCHES = 4096;      // Further moves are answered "error busy"
+const size_t SERVER_MAX_CACHE_ENTRIES = 1 << 20;     // Per worker; the cache is cleared past this
+const int SERVER_DEFAULT_MOVE_TIME = 200;            // Hard search budget per move, milliseconds
+
+struct Session {
+    int fd;
+    uint64_t id;               // Unique per connection; stale search results are dropped
+    Board board;
+    AILevel level;
+    CellState clientSide;
+    bool inGame;
+    bool searching;            // Input is held back while the AI is thinking
+    bool closing;              // Close once the output is flushed
+    bool wantWrite;            // EPOLLOUT is registered
+    std::string input;
+    std::string output;
+
+    Session() : fd(-1), id(0), level(MEDIUM), clientSide(PLAYER_X), inGame(false), searching(false),
+                closing(false), wantWrite(false) {}
+};
+
+struct SearchJob {
+    Session* session;
+    uint64_t sessionId;
+    Board board;
+    AILevel level;
+    CellState aiSide;
+};
+
+struct SearchResult {
+    Session* session;
+    uint64_t sessionId;
+    std::pair<int, int> move;
+};
+
+struct ServerOptions {
+    int port;
+    std::string unixPath;      // Listen on a Unix socket instead of TCP
+    int workers;
+    int maxSessions;
+    int moveTimeMs;            // 0 = Hard searches to its full depth
+
+    ServerOptions()
+        : port(SERVER_DEFAULT_PORT), workers(0), maxSessions(10000), moveTimeMs(SERVER_DEFAULT_MOVE_TIME) {}
+};
+
+volatile sig_atomic_t stopSignal = 0;
+
+void handleSignal(int) {
+    stopSignal = 1;
+}
+
+const char* getResultText(const Board& board) {
+    WinInfo winInfo = board.checkWin();
+    if (winInfo.hasWinner) return (winInfo.winner == PLAYER_X) ? "x" : "o";
+    if (board.isFull()) return "draw";
+    return nullptr;
+}
+
+class GameServer {
+public:
+    GameServer(const ServerOptions& options)
+        : options(options), listenFd(-1), epollFd(-1), wakeFd(-1), jobs(SERVER_MAX_QUEUED_SEARCHES),
+          stopSearches(false), nextSessionId(1), totalSessions(0), totalMoves(0), totalGames(0) {}
+
+    ~GameServer() {
+        if (listenFd != -1) close(listenFd);
+        if (epollFd != -1) close(epollFd);
+        if (wakeFd != -1) close(wakeFd);
+        if (!options.unixPath.empty()) unlink(options.unixPath.c_str());
+    }
+
+    bool start() {
+        epollFd = epoll_create1(0);
+        wakeFd = eventfd(0, EFD_NONBLOCK);
+        if (epollFd == -1 || wakeFd == -1) {
+            std::cerr << "epoll/eventfd failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+        if (!openListenSocket()) return false;
+
+        addToEpoll(listenFd, EPOLLIN, 0);
+        addToEpoll(wakeFd, EPOLLIN, 1);
+
+        int workerCount = options.workers;
+        if (workerCount <= 0) workerCount = std::max(1u, std::thread::hardware_concurrency());
+        for (int i = 0; i < workerCount; i++) {
+            workers.emplace_back(&GameServer::runWorker, this);
+        }
+
+        if (options.unixPath.empty()) {
+            std::cout << "Listening on 127.0.0.1:" << options.port;
+        } else {
+            std::cout << "Listening on " << options.unixPath;
+        }
+        std::cout << " with " << workerCount << " search workers\n";
+        return true;
+    }
+
+    void run() {
+        std::vector<epoll_event> events(SERVER_MAX_EVENTS);
+
+        while (!stopSignal) {
+            int count = epoll_wait(epollFd, events.data(), (int)events.size(), 500);
+            if (count < 0) {
+                if (errno == EINTR) continue;
+                std::cerr << "epoll_wait failed: " << std::strerror(errno) << "\n";
+                break;
+            }
+
+            // Accept after the batch so a session closed in this batch
+            // cannot be reused while stale events still point at it
+            bool acceptPending = false;
+            for (int i = 0; i < count; i++) {
+                uint64_t tag = events[i].data.u64;
+                if (tag == 0) {
+                    acceptPending = true;
+                } else if (tag == 1) {
+                    drainCompletions();
+                } else {
+                    handleSessionEvent(reinterpret_cast<Session*>(tag), events[i].events);
+                }
+            }
+            if (acceptPending) acceptConnections();
+        }
+
+        // Nobody is waiting for the results: drop queued searches and end
+        // the running ones at their next stop-flag poll
+        stopSearches = true;
+        jobs.clear();
+        jobs.close();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        std::cout << "\nServed " << totalSessions << " sessions, " << totalGames << " games, "
+                  << totalMoves << " AI moves\n";
+    }
+
+private:
+    ServerOptions options;
+    int listenFd;
+    int epollFd;
+    int wakeFd;
+    ObjectPool<Session> sessions;
+    BoundedQueue<SearchJob> jobs;
+    std::atomic<bool> stopSearches;
+    std::vector<std::thread> workers;
+    std::mutex completionMutex;
+    std::vector<SearchResult> completions;
+    std::vector<SearchResult> completionBatch;
+    uint64_t nextSessionId;
+    unsigned long long totalSessions;
+    unsigned long long totalMoves;
+    unsigned long long totalGames;
+
+    bool openListenSocket() {
+        if (options.unixPath.empty()) {
+            listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+            int reuse = 1;
+            setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+            sockaddr_in address;
+            std::memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_port = htons((uint16_t)options.port);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            if (listenFd == -1 || bind(listenFd, (sockaddr*)&address, sizeof(address)) != 0) {
+                std::cerr << "Cannot bind port " << options.port << ": " << std::strerror(errno) << "\n";
+                return false;
+            }
+        } else {
+            listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+            unlink(options.unixPath.c_str());
+
+            sockaddr_un address;
+            std::memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, options.unixPath.c_str(), sizeof(address.sun_path) - 1);
+            if (listenFd == -1 || bind(listenFd, (sockaddr*)&address, sizeof(address)) != 0) {
+                std::cerr << "Cannot bind " << options.unixPath << ": " << std::strerror(errno) << "\n";
+                return false;
+            }
+        }
+
+        if (listen(listenFd, SOMAXCONN) != 0) {
+            std::cerr << "listen failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    void addToEpoll(int fd, uint32_t events, uint64_t tag) {
+        epoll_event event;
+        event.events = events;
+        event.data.u64 = tag;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    void acceptConnections() {
+        while (true) {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK);
+            if (fd == -1) return;  // EAGAIN: no more pending connections
+
+            if ((int)sessions.getLiveCount() >= options.maxSessions) {
+                close(fd);
+                continue;
+            }
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+            Session* session = sessions.acquire();
+            session->fd = fd;
+            session->id = nextSessionId++;
+            session->inGame = false;
+            session->searching = false;
+            session->closing = false;
+            session->wantWrite = false;
+            session->input.clear();
+            session->output.clear();
+            totalSessions++;
+
+            addToEpoll(fd, EPOLLIN | EPOLLRDHUP, reinterpret_cast<uint64_t>(session));
+        }
+    }
+
+    void closeSession(Session* session) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, session->fd, nullptr);
+        close(session->fd);
+        session->fd = -1;
+        session->id = 0;  // Any search still running for it is discarded
+        sessions.release(session);
+    }
+
+    void handleSessionEvent(Session* session, uint32_t events) {
+        if (session->fd == -1) return;  // Closed earlier in this batch
+        if (events & (EPOLLERR | EPOLLHUP)) {
+            closeSession(session);
+            return;
+        }
+        if ((events & EPOLLOUT) && !flushOutput(session)) {
+            return;
+        }
+        if (events & (EPOLLIN | EPOLLRDHUP)) {
+            char buffer[4096];
+            while (true) {
+                ssize_t received = read(session->fd, buffer, sizeof(buffer));
+                if (received > 0) {
+                    session->input.append(buffer, (size_t)received);
+                    if (session->input.size() > (size_t)SERVER_MAX_INPUT) {
+                        // Input piles up while a search runs; don't let a client grow it forever
+                        session->input.clear();
+                        send(session, "error input limit exceeded");
+                        session->closing = true;
+                        flushOutput(session);
+                        return;
+                    }
+                    continue;
+                }
+                if (received == -1 && errno == EINTR) continue;
+                if (received == 0 || errno != EAGAIN) {
+                    closeSession(session);  // Peer closed or failed
+                    return;
+                }
+                break;
+            }
+            processInput(session);
+        }
+    }
+
+    // Handles complete lines until a search is started or input runs out
+    void processInput(Session* session) {
+        while (!session->searching && !session->closing) {
+            size_t end = session->input.find('\n');
+            if (end == std::string::npos) {
+                if (session->input.size() > (size_t)SERVER_MAX_LINE) {
+                    send(session, "error line too long");
+                    session->closing = true;
+                }
+                break;
+            }
+
+            std::string line = session->input.substr(0, end);
+            session->input.erase(0, end + 1);
+            if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+            handleCommand(session, line);
+        }
+        flushOutput(session);
+    }
+
+    void handleCommand(Session* session, const std::string& line) {
+        std::istringstream args(line);
+        std::string command;
+        args >> command;
+
+        if (command == "new") {
+            startGame(session, args);
+        } else if (command == "move") {
+            std::string token;
+            args >> token;
+            playClientMove(session, token);
+        } else if (command == "quit") {
+            session->closing = true;
+        } else if (!command.empty()) {
+            send(session, "error unknown command");
+        }
+    }
+
+    void startGame(Session* session, std::istringstream& args) {
+        int size = 3;
+        int winCondition = 0;
+        bool sizeSet = false;
+        AILevel level = MEDIUM;
+        CellState side = PLAYER_X;
+
+        std::string token;
+        while (args >> token) {
+            if (token == "easy") level = EASY;
+            else if (token == "medium") level = MEDIUM;
+            else if (token == "hard") level = HARD;
+            else if (token == "neural") level = NEURAL;
+            else if (token == "x") side = PLAYER_X;
+            else if (token == "o") side = PLAYER_O;
+            else if (!sizeSet) { size = std::atoi(token.c_str()); sizeSet = true; }
+            else winCondition = std::atoi(token.c_str());
+        }
+
+        if (size < 3 || size > 6) {
+            send(session, "error size must be between 3 and 6");
+            return;
+        }
+        if (winCondition <= 0) winCondition = getDefaultWinCondition(size);
+        if (winCondition < 3 || winCondition > size) {
+            send(session, "error win condition out of range");
+            return;
+        }
+
+        session->board.resize(size, winCondition);
+        session->level = level;
+        session->clientSide = side;
+        session->inGame = true;
+
+        // "ok" still goes out before the AI's move: completions are only
+        // handled on this thread
+        if (side == PLAYER_O && !dispatchSearch(session)) {
+            session->inGame = false;
+            send(session, "error busy");
+            return;
+        }
+        send(session, "ok");
+    }
+
+    void playClientMove(Session* session, const std::string& token) {
+        int row = -1;
+        int col = -1;
+        char comma = 0;
+        std::istringstream move(token);
+
+        if (!session->inGame) {
+            send(session, "error no game in progress");
+        } else if (!(move >> row >> comma >> col) || comma != ',' ||
+                   !session->board.makeMove(row, col, session->clientSide)) {
+            send(session, "error illegal move");
+        } else if (!finishIfOver(session) && !dispatchSearch(session)) {
+            session->board.undoMove(row, col);  // The client may send the move again
+            send(session, "error busy");
+        }
+    }
+
+    bool finishIfOver(Session* session) {
+        const char* result = getResultText(session->board);
+        if (!result) return false;
+
+        send(session, std::string("result ") + result);
+        session->inGame = false;
+        totalGames++;
+        return true;
+    }
+
+    // Never blocks the I/O thread: false if the search queue is full
+    bool dispatchSearch(Session* session) {
+        SearchJob job;
+        job.session = session;
+        job.sessionId = session->id;
+        job.board = session->board;
+        job.level = session->level;
+        job.aiSide = (session->clientSide == PLAYER_X) ? PLAYER_O : PLAYER_X;
+
+        if (!jobs.tryPush(job)) return false;
+        session->searching = true;
+        return true;
+    }
+
+    void runWorker() {
+        AI ai;
+        ai.setPersistentCache(false);  // Workers must not write the shared cache files
+        ai.setStopFlag(&stopSearches);
+
+        SearchJob job;
+        while (jobs.pop(job)) {
+            ai.setLevel(job.level);
+            ai.setTimeLimit(options.moveTimeMs);  // Bounds Hard replies however many sessions wait
+
+            SearchResult result;
+            result.session = job.session;
+            result.sessionId = job.sessionId;
+            result.move = ai.getMove(job.board, job.aiSide);
+
+            // A worker's AI lives as long as the server; bound its cache
+            if (ai.getCacheEntryCount() > SERVER_MAX_CACHE_ENTRIES) {
+                ai.clearCache();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(completionMutex);
+                completions.push_back(result);
+            }
+            uint64_t one = 1;
+            ssize_t written = write(wakeFd, &one, sizeof(one));
+            (void)written;
+        }
+    }
+
+    void drainCompletions() {
+        uint64_t counter;
+        ssize_t received = read(wakeFd, &counter, sizeof(counter));
+        (void)received;
+
+        {
+            std::lock_guard<std::mutex> lock(completionMutex);
+            completionBatch.swap(completions);
+        }
+
+        for (const auto& result : completionBatch) {
+            Session* session = result.session;
+            if (session->id != result.sessionId) continue;  // Disconnected meanwhile
+
+            session->searching = false;
+            session->board.makeMove(result.move.first, result.move.second,
+                                    (session->clientSide == PLAYER_X) ? PLAYER_O : PLAYER_X);
+            totalMoves++;
+
+            send(session, "move " + std::to_string(result.move.first) + "," + std::to_string(result.move.second));
+            finishIfOver(session);
+            processInput(session);  // Lines that arrived during the search
+        }
+        completionBatch.clear();
+    }
+
+    void send(Session* session, const std::string& line) {
+        session->output += line;
+        session->output += '\n';
+    }
+
+    // Writes as much as the socket accepts; returns false if the session was closed
+    bool flushOutput(Session* session) {
+        while (!session->output.empty()) {
+            ssize_t sent = ::send(session->fd, session->output.data(), session->output.size(), MSG_NOSIGNAL);
+            if (sent > 0) {
+                session->output.erase(0, (size_t)sent);
+            } else if (sent == -1 && errno == EAGAIN) {
+                break;
+            } else {
+                closeSession(session);
+                return false;
+            }
+        }
+
+        if (session->output.empty() && session->closing) {
+            closeSession(session);
+            return false;
+        }
+
+        // Only watch for writability while output is backed up
+        bool wantWrite = !session->output.empty();
+        if (wantWrite != session->wantWrite) {
+            epoll_event event;
+            event.events = EPOLLIN | EPOLLRDHUP | (wantWrite ? (uint32_t)EPOLLOUT : 0u);
+            event.data.u64 = reinterpret_cast<uint64_t>(session);
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, session->fd, &event);
+            session->wantWrite = wantWrite;
+        }
+        return true;
+    }
+};
+
+}  // namespace
+
+void printUsage() {
+    std::cout << "Usage: game_server [--port P | --unix PATH] [--workers W] [--max-sessions N] [--move-time MS]\n";
+    std::cout << "  --move-time limits each Hard search (default " << SERVER_DEFAULT_MOVE_TIME << ", 0 = full depth)\n";
+}
+
+int main(int argc, char* argv[]) {
+    ServerOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--port") options.port = std::atoi(value.c_str());
+        else if (arg == "--unix") options.unixPath = value;
+        else if (arg == "--workers") options.workers = std::atoi(value.c_str());
+        else if (arg == "--max-sessions") options.maxSessions = std::atoi(value.c_str());
+        else if (arg == "--move-time") options.moveTimeMs = std::atoi(value.c_str());
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+    signal(SIGPIPE, SIG_IGN);
+
+    GameServer server(options);
+    if (!server.start()) {
+        return 1;
+    }
+    server.run();
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cerr << "game_server uses epoll and is only available on Linux\n";
+    return 1;
+}
+
+#endif
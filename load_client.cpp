@@ -0,0 +1,291 @@
+#include <iostream>
+
+#ifdef __linux__
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "ServerProtocol.h"
+
+// Load generator for game_server. Opens many sessions from one epoll loop,
+// each playing random legal moves as X against the server's AI in
+// back-to-back games, and reports moves/sec and the latency from sending a
+// move to receiving the AI's reply.
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct ClientOptions {
+    int port;
+    std::string unixPath;
+    int sessions;
+    int durationSec;
+    int boardSize;
+    std::string level;
+
+    ClientOptions() : port(SERVER_DEFAULT_PORT), sessions(100), durationSec(10), boardSize(3), level("medium") {}
+};
+
+struct ClientSession {
+    int fd;
+    Board board;
+    bool waitingForReply;
+    Clock::time_point sentAt;
+    std::string input;
+};
+
+struct LoadStats {
+    unsigned long long games;
+    unsigned long long errors;
+    std::vector<double> latenciesMs;
+
+    LoadStats() : games(0), errors(0) {}
+};
+
+int connectToServer(const ClientOptions& options) {
+    int fd;
+    int result;
+    if (options.unixPath.empty()) {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons((uint16_t)options.port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        result = connect(fd, (sockaddr*)&address, sizeof(address));
+
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    } else {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, options.unixPath.c_str(), sizeof(address.sun_path) - 1);
+        result = connect(fd, (sockaddr*)&address, sizeof(address));
+    }
+
+    if (fd == -1 || result != 0) {
+        if (fd != -1) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+class LoadClient {
+public:
+    LoadClient(const ClientOptions& options) : options(options), gen(12345), epollFd(-1) {}
+
+    ~LoadClient() {
+        for (auto& session : sessions) {
+            if (session.fd != -1) close(session.fd);
+        }
+        if (epollFd != -1) close(epollFd);
+    }
+
+    bool run() {
+        epollFd = epoll_create1(0);
+        sessions.resize(options.sessions);
+
+        // Connect blocking, then switch to non-blocking I/O for the run
+        for (int i = 0; i < options.sessions; i++) {
+            ClientSession& session = sessions[i];
+            session.fd = connectToServer(options);
+            if (session.fd == -1) {
+                std::cerr << "Connect failed after " << i << " sessions: " << std::strerror(errno)
+                          << " (raise the open file limit with ulimit -n)\n";
+                return false;
+            }
+            session.waitingForReply = false;
+
+            fcntl(session.fd, F_SETFL, fcntl(session.fd, F_GETFL, 0) | O_NONBLOCK);
+            epoll_event event;
+            event.events = EPOLLIN;
+            event.data.u32 = (uint32_t)i;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, session.fd, &event);
+            startGame(session);
+        }
+
+        stats.latenciesMs.reserve(1 << 20);
+        auto start = Clock::now();
+        auto end = start + std::chrono::seconds(options.durationSec);
+        std::vector<epoll_event> events(SERVER_MAX_EVENTS);
+
+        while (Clock::now() < end) {
+            int count = epoll_wait(epollFd, events.data(), (int)events.size(), 100);
+            for (int i = 0; i < count; i++) {
+                if (!handleReadable(sessions[events[i].data.u32])) return false;
+            }
+        }
+
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        printReport(seconds);
+        return true;
+    }
+
+private:
+    ClientOptions options;
+    std::mt19937 gen;
+    int epollFd;
+    std::vector<ClientSession> sessions;
+    LoadStats stats;
+
+    // Requests are a few bytes and one is outstanding per session, so the
+    // socket buffer always has room
+    void send(ClientSession& session, const std::string& line) {
+        std::string message = line + "\n";
+        ssize_t sent = ::send(session.fd, message.data(), message.size(), MSG_NOSIGNAL);
+        if (sent != (ssize_t)message.size()) stats.errors++;
+    }
+
+    void startGame(ClientSession& session) {
+        session.board.resize(options.boardSize, getDefaultWinCondition(options.boardSize));
+        send(session, "new " + std::to_string(options.boardSize) + " " + options.level + " x");
+    }
+
+    void playRandomMove(ClientSession& session) {
+        auto emptyCells = session.board.getEmptyCells();
+        std::uniform_int_distribution<> dis(0, (int)emptyCells.size() - 1);
+        auto cell = emptyCells[dis(gen)];
+        session.board.makeMove(cell.first, cell.second, PLAYER_X);
+
+        session.waitingForReply = true;
+        session.sentAt = Clock::now();
+        send(session, "move " + std::to_string(cell.first) + "," + std::to_string(cell.second));
+    }
+
+    bool handleReadable(ClientSession& session) {
+        char buffer[4096];
+        ssize_t received = read(session.fd, buffer, sizeof(buffer));
+        if (received == 0 || (received < 0 && errno != EAGAIN)) {
+            std::cerr << "Server closed a session\n";
+            return false;
+        }
+        if (received > 0) session.input.append(buffer, (size_t)received);
+
+        size_t end;
+        while ((end = session.input.find('\n')) != std::string::npos) {
+            std::string line = session.input.substr(0, end);
+            session.input.erase(0, end + 1);
+            handleLine(session, line);
+        }
+        return true;
+    }
+
+    void handleLine(ClientSession& session, const std::string& line) {
+        std::istringstream args(line);
+        std::string command;
+        args >> command;
+
+        if (command == "ok") {
+            playRandomMove(session);
+        } else if (command == "move") {
+            int row = -1;
+            int col = -1;
+            char comma = 0;
+            args >> row >> comma >> col;
+            if (session.waitingForReply) {
+                stats.latenciesMs.push_back(
+                    std::chrono::duration<double, std::milli>(Clock::now() - session.sentAt).count());
+                session.waitingForReply = false;
+            }
+            session.board.makeMove(row, col, PLAYER_O);
+
+            // If the AI's move ended the game a result line follows
+            if (!session.board.checkWin().hasWinner && !session.board.isFull()) {
+                playRandomMove(session);
+            }
+        } else if (command == "result") {
+            stats.games++;
+            session.waitingForReply = false;
+            startGame(session);
+        } else {
+            stats.errors++;
+            startGame(session);
+        }
+    }
+
+    void printReport(double seconds) {
+        std::vector<double>& latencies = stats.latenciesMs;
+        std::sort(latencies.begin(), latencies.end());
+
+        auto percentile = [&latencies](double p) {
+            if (latencies.empty()) return 0.0;
+            size_t index = std::min(latencies.size() - 1, (size_t)(p * latencies.size()));
+            return latencies[index];
+        };
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "Sessions:   " << options.sessions << " (" << options.boardSize << "x" << options.boardSize
+                  << ", " << options.level << ")\n";
+        std::cout << "Games:      " << stats.games << "\n";
+        std::cout << "AI moves:   " << latencies.size() << " (" << latencies.size() / seconds << " moves/sec)\n";
+        std::cout << "Latency ms: p50 " << percentile(0.50) << "  p90 " << percentile(0.90) << "  p99 "
+                  << percentile(0.99) << "  max " << (latencies.empty() ? 0.0 : latencies.back()) << "\n";
+        std::cout << "Errors:     " << stats.errors << "\n";
+    }
+};
+
+}  // namespace
+
+void printUsage() {
+    std::cout << "Usage: load_client [--port P | --unix PATH] [--sessions N] [--duration SEC] [--size N] [--level LEVEL]\n";
+}
+
+int main(int argc, char* argv[]) {
+    ClientOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--port") options.port = std::atoi(value.c_str());
+        else if (arg == "--unix") options.unixPath = value;
+        else if (arg == "--sessions") options.sessions = std::atoi(value.c_str());
+        else if (arg == "--duration") options.durationSec = std::atoi(value.c_str());
+        else if (arg == "--size") options.boardSize = std::atoi(value.c_str());
+        else if (arg == "--level") options.level = value;
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (options.sessions <= 0 || options.boardSize < 3 || options.boardSize > 6) {
+        printUsage();
+        return 1;
+    }
+
+    LoadClient client(options);
+    return client.run() ? 0 : 1;
+}
+
+#else
+
+int main() {
+    std::cerr << "load_client uses epoll and is only available on Linux\n";
+    return 1;
+}
+
+#endif
@@ -1,14 +1,37 @@
 #include "Game.h"
+#include <cstdlib>
 #include <iostream>
+#include <string>
 
 int main(int argc, char* argv[]) {
+    // --render-bench [FRAMES]: time rendering headlessly instead of playing
+    bool renderBench = false;
+    int benchFrames = RENDER_BENCH_DEFAULT_FRAMES;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--render-bench") {
+            renderBench = true;
+            if (i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+                benchFrames = std::atoi(argv[++i]);
+            }
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--render-bench [FRAMES]]" << std::endl;
+            return 1;
+        }
+    }
+    
     Game game;
     
-    if (!game.initialize()) {
+    if (!game.initialize(renderBench)) {
         std::cerr << "Failed to initialize game!" << std::endl;
         return -1;
     }
     
+    if (renderBench) {
+        game.runRenderBenchmark(benchFrames);
+        return 0;
+    }
+    
     game.run();
     
     return 0;
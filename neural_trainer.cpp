@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "AI.h"
+#include "NeuralNet.h"
+#include "OpeningBook.h"
+
+// Regenerates the NEURAL level's weights locally:
+//   neural_trainer selfplay  plays Hard-vs-Hard games and dumps every position
+//   neural_trainer train     fits nn_<N>x<N>_<win>.bin to a dump with SGD
+//
+// Dump records are fixed-size so the file can be streamed or memory-mapped:
+// cells are stored relative to the side to move (1 = own, 2 = opponent).
+struct TrainingSample {
+    uint8_t boardSize;
+    uint8_t winCondition;
+    uint8_t bestMove;   // Cell index chosen by the engine
+    int8_t result;      // Final result for the side to move: 1 win, 0 draw, -1 loss
+    uint8_t cells[36];
+};
+
+struct TrainerOptions {
+    int boardSize;
+    int winCondition;
+    int games;
+    int randomPlies;
+    int epochs;
+    float learningRate;
+    unsigned int seed;
+    std::string dataFile;
+    std::string outputFile;
+    
+    TrainerOptions() : boardSize(3), winCondition(0), games(200), randomPlies(2), epochs(30),
+                       learningRate(0.01f), seed(1), dataFile(), outputFile() {}
+};
+
+std::string getDefaultDataFile(int size, int winCondition) {
+    return "nn_data_" + std::to_string(size) + "x" + std::to_string(size) + "_" + std::to_string(winCondition) + ".bin";
+}
+
+int runSelfPlay(const TrainerOptions& options) {
+    std::ofstream out(options.dataFile, std::ios::binary | std::ios::app);
+    if (!out.is_open()) {
+        std::cerr << "Cannot open " << options.dataFile << "\n";
+        return 1;
+    }
+    
+    AI engine(HARD);
+    engine.setPersistentCache(false);
+    std::mt19937 gen(options.seed);
+    int size = options.boardSize;
+    long samplesWritten = 0;
+    
+    for (int game = 0; game < options.games; game++) {
+        Board board(size, options.winCondition);
+        CellState toMove = PLAYER_X;
+        std::vector<TrainingSample> samples;
+        std::vector<CellState> movers;
+        
+        for (int ply = 0; !board.checkWin().hasWinner && !board.isFull(); ply++) {
+            auto emptyCells = board.getEmptyCells();
+            std::pair<int, int> move;
+            
+            if (ply < options.randomPlies) {
+                // Random openings keep the games from repeating
+                std::uniform_int_distribution<> dis(0, (int)emptyCells.size() - 1);
+                move = emptyCells[dis(gen)];
+            } else {
+                // Record the engine's choice, picking randomly among equal best moves
+                auto analysis = engine.analyze(board, toMove);
+                int bestScore = analysis[0].score;
+                for (const auto& candidate : analysis) bestScore = std::max(bestScore, candidate.score);
+                
+                std::vector<std::pair<int, int>> bestMoves;
+                for (const auto& candidate : analysis) {
+                    if (candidate.score == bestScore) bestMoves.push_back({candidate.row, candidate.col});
+                }
+                std::uniform_int_distribution<> dis(0, (int)bestMoves.size() - 1);
+                move = bestMoves[dis(gen)];
+                
+                TrainingSample sample;
+                std::memset(&sample, 0, sizeof(sample));
+                sample.boardSize = (uint8_t)size;
+                sample.winCondition = (uint8_t)options.winCondition;
+                sample.bestMove = (uint8_t)(move.first * size + move.second);
+                for (int cell = 0; cell < size * size; cell++) {
+                    CellState state = board.getCell(cell / size, cell % size);
+                    sample.cells[cell] = (state == EMPTY) ? 0 : (state == toMove ? 1 : 2);
+                }
+                samples.push_back(sample);
+                movers.push_back(toMove);
+            }
+            
+            board.makeMove(move.first, move.second, toMove);
+            toMove = (toMove == PLAYER_X) ? PLAYER_O : PLAYER_X;
+        }
+        
+        WinInfo winInfo = board.checkWin();
+        for (size_t i = 0; i < samples.size(); i++) {
+            if (winInfo.hasWinner) {
+                samples[i].result = (winInfo.winner == movers[i]) ? 1 : -1;
+            }
+            out.write(reinterpret_cast<const char*>(&samples[i]), sizeof(TrainingSample));
+        }
+        samplesWritten += (long)samples.size();
+        
+        if ((game + 1) % 10 == 0) {
+            std::cout << "  " << (game + 1) << "/" << options.games << " games, " << samplesWritten << " positions\n";
+        }
+    }
+    
+    std::cout << "Wrote " << samplesWritten << " positions to " << options.dataFile << "\n";
+    return 0;
+}
+
+int runTraining(const TrainerOptions& options) {
+    std::ifstream in(options.dataFile, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Cannot open " << options.dataFile << "\n";
+        return 1;
+    }
+    
+    std::vector<TrainingSample> samples;
+    TrainingSample sample;
+    while (in.read(reinterpret_cast<char*>(&sample), sizeof(sample))) {
+        if (sample.boardSize == options.boardSize && sample.winCondition == options.winCondition) {
+            samples.push_back(sample);
+        }
+    }
+    if (samples.empty()) {
+        std::cerr << "No " << options.boardSize << "x" << options.boardSize << " positions in " << options.dataFile << "\n";
+        return 1;
+    }
+    
+    int size = options.boardSize;
+    int cells = size * size;
+    NeuralWeights weights;
+    weights.initialize(size, options.winCondition, NEURAL_HIDDEN_SIZE, options.seed);
+    int hiddenSize = weights.hiddenSize;
+    
+    std::mt19937 gen(options.seed);
+    std::uniform_int_distribution<> symmetryDist(0, 7);
+    std::vector<int> order(samples.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = (int)i;
+    
+    std::vector<int> active;
+    std::vector<float> preActivation(hiddenSize), hidden(hiddenSize), hiddenGrad(hiddenSize);
+    std::vector<float> logits(cells), logitGrad(cells);
+    float lr = options.learningRate;
+    
+    std::cout << "Training on " << samples.size() << " positions for " << options.epochs << " epochs\n";
+    
+    for (int epoch = 0; epoch < options.epochs; epoch++) {
+        std::shuffle(order.begin(), order.end(), gen);
+        double policyLoss = 0.0, valueLoss = 0.0;
+        int correct = 0;
+        
+        for (int index : order) {
+            const TrainingSample& s = samples[index];
+            
+            // Augment with a random rotation/reflection of the position
+            int symmetry = symmetryDist(gen);
+            int target = OpeningBook::transformCell(s.bestMove, size, symmetry);
+            std::vector<uint8_t> cellState(cells);
+            active.clear();
+            for (int cell = 0; cell < cells; cell++) {
+                int mapped = OpeningBook::transformCell(cell, size, symmetry);
+                cellState[mapped] = s.cells[cell];
+                if (s.cells[cell] == 1) active.push_back(mapped);
+                if (s.cells[cell] == 2) active.push_back(cells + mapped);
+            }
+            
+            // Forward pass
+            for (int j = 0; j < hiddenSize; j++) preActivation[j] = weights.hiddenBias[j];
+            for (int input : active) {
+                for (int j = 0; j < hiddenSize; j++) preActivation[j] += weights.inputWeights[input * hiddenSize + j];
+            }
+            for (int j = 0; j < hiddenSize; j++) hidden[j] = std::max(preActivation[j], 0.0f);
+            
+            float maxLogit = -1e30f;
+            for (int c = 0; c < cells; c++) {
+                float sum = weights.policyBias[c];
+                for (int j = 0; j < hiddenSize; j++) sum += weights.policyWeights[c * hiddenSize + j] * hidden[j];
+                logits[c] = sum;
+                if (cellState[c] == 0) maxLogit = std::max(maxLogit, sum);
+            }
+            
+            // Softmax over the legal moves only
+            float total = 0.0f;
+            int predicted = -1;
+            for (int c = 0; c < cells; c++) {
+                logitGrad[c] = (cellState[c] == 0) ? std::exp(logits[c] - maxLogit) : 0.0f;
+                total += logitGrad[c];
+                if (cellState[c] == 0 && (predicted == -1 || logits[c] > logits[predicted])) predicted = c;
+            }
+            for (int c = 0; c < cells; c++) logitGrad[c] /= total;
+            policyLoss -= std::log(std::max(logitGrad[target], 1e-12f));
+            logitGrad[target] -= 1.0f;
+            if (predicted == target) correct++;
+            
+            float valueSum = weights.valueBias;
+            for (int j = 0; j < hiddenSize; j++) valueSum += weights.valueWeights[j] * hidden[j];
+            float value = std::tanh(valueSum);
+            float valueError = value - (float)s.result;
+            valueLoss += valueError * valueError;
+            float valueGrad = 2.0f * valueError * (1.0f - value * value);
+            
+            // Backward pass and SGD update
+            for (int j = 0; j < hiddenSize; j++) {
+                float grad = valueGrad * weights.valueWeights[j];
+                for (int c = 0; c < cells; c++) grad += logitGrad[c] * weights.policyWeights[c * hiddenSize + j];
+                hiddenGrad[j] = (preActivation[j] > 0.0f) ? grad : 0.0f;
+            }
+            for (int c = 0; c < cells; c++) {
+                for (int j = 0; j < hiddenSize; j++) weights.policyWeights[c * hiddenSize + j] -= lr * logitGrad[c] * hidden[j];
+                weights.policyBias[c] -= lr * logitGrad[c];
+            }
+            for (int j = 0; j < hiddenSize; j++) weights.valueWeights[j] -= lr * valueGrad * hidden[j];
+            weights.valueBias -= lr * valueGrad;
+            for (int input : active) {
+                for (int j = 0; j < hiddenSize; j++) weights.inputWeights[input * hiddenSize + j] -= lr * hiddenGrad[j];
+            }
+            for (int j = 0; j < hiddenSize; j++) weights.hiddenBias[j] -= lr * hiddenGrad[j];
+        }
+        
+        std::cout << "  epoch " << (epoch + 1) << ": policy loss " << policyLoss / samples.size()
+                  << ", value loss " << valueLoss / samples.size()
+                  << ", move accuracy " << (100.0 * correct / samples.size()) << "%\n";
+    }
+    
+    if (!NeuralNet::saveWeights(options.outputFile, weights)) {
+        std::cerr << "Failed to write " << options.outputFile << "\n";
+        return 1;
+    }
+    std::cout << "Wrote weights to " << options.outputFile << "\n";
+    return 0;
+}
+
+void printUsage() {
+    std::cout << "Usage: neural_trainer selfplay [--size N] [--win W] [--games G] [--random-plies P] [--data FILE] [--seed S]\n";
+    std::cout << "       neural_trainer train [--size N] [--win W] [--epochs E] [--lr RATE] [--data FILE] [--out FILE] [--seed S]\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+    
+    std::string command = argv[1];
+    TrainerOptions options;
+    
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        
+        if (arg == "--size") options.boardSize = std::atoi(argv[++i]);
+        else if (arg == "--win") options.winCondition = std::atoi(argv[++i]);
+        else if (arg == "--games") options.games = std::atoi(argv[++i]);
+        else if (arg == "--random-plies") options.randomPlies = std::atoi(argv[++i]);
+        else if (arg == "--epochs") options.epochs = std::atoi(argv[++i]);
+        else if (arg == "--lr") options.learningRate = (float)std::atof(argv[++i]);
+        else if (arg == "--seed") options.seed = (unsigned int)std::atoi(argv[++i]);
+        else if (arg == "--data") options.dataFile = argv[++i];
+        else if (arg == "--out") options.outputFile = argv[++i];
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    
+    if (options.boardSize < 3 || options.boardSize > 6) {
+        std::cerr << "Board size must be between 3 and 6\n";
+        return 1;
+    }
+    if (options.winCondition <= 0) options.winCondition = getDefaultWinCondition(options.boardSize);
+    if (options.dataFile.empty()) options.dataFile = getDefaultDataFile(options.boardSize, options.winCondition);
+    if (options.outputFile.empty()) options.outputFile = NeuralNet::getFileName(options.boardSize, options.winCondition);
+    
+    if (command == "selfplay") {
+        return runSelfPlay(options);
+    } else if (command == "train") {
+        return runTraining(options);
+    }
+    
+    printUsage();
+    return 1;
+}
\ No newline at end of file
@@ -0,0 +1,313 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Board.h"
+
+// Perft-style move generation check. Counts every legal continuation to a
+// fixed depth, stopping at won or full boards, using Board::makeMove,
+// undoMove and checkWin. The counts are compared against known-good values
+// and against an independent naive implementation, so one run checks both
+// the correctness and the raw speed of the board code.
+struct PerftCase {
+    int boardSize;
+    int winCondition;
+    std::string position;  // Row-major 'X', 'O' or '.', empty string = empty board
+    int depth;
+};
+
+struct PerftOptions {
+    bool useSuite;
+    bool verify;
+    PerftCase single;
+
+    PerftOptions() : useSuite(true), verify(true) {
+        single.boardSize = 3;
+        single.winCondition = 0;
+        single.depth = 0;
+    }
+};
+
+// Known-good leaf counts for standard 3x3 tic-tac-toe, depth 1..9
+const unsigned long long REFERENCE_3X3[9] = {
+    9ULL, 72ULL, 504ULL, 3024ULL, 15120ULL, 54720ULL, 148176ULL, 200448ULL, 127872ULL
+};
+
+// Default suite: empty boards at every size plus mid-game positions with
+// live threats so win detection is exercised on the larger boards too
+const PerftCase DEFAULT_SUITE[] = {
+    {3, 3, "", 9},
+    {4, 4, "", 6},
+    {4, 4, "XO.." ".XO." "..X." "O...", 8},
+    {5, 4, "", 5},
+    {5, 4, "X.O.." ".XO.." "..X.." "....." "O....", 5},
+    {6, 5, "", 4},
+    {6, 5, "X....O" ".X..O." "..X..." "...X.." "......" "O...O.", 4}
+};
+
+class Perft {
+public:
+    Perft() : nodes(0) {}
+
+    // Number of positions exactly depth plies ahead; positions that end
+    // the game earlier have no continuations and contribute nothing
+    unsigned long long count(Board& board, CellState toMove, int depth) {
+        if (depth == 0) return 1;
+        if (board.checkWin().hasWinner || board.isFull()) return 0;
+
+        CellState next = (toMove == PLAYER_X) ? PLAYER_O : PLAYER_X;
+        int size = board.getSize();
+        unsigned long long leaves = 0;
+
+        for (int row = 0; row < size; row++) {
+            for (int col = 0; col < size; col++) {
+                if (board.getCell(row, col) != EMPTY) continue;
+
+                board.makeMove(row, col, toMove);
+                nodes++;
+                leaves += count(board, next, depth - 1);
+                board.undoMove(row, col);
+            }
+        }
+
+        return leaves;
+    }
+
+    unsigned long long getNodes() const {
+        return nodes;
+    }
+
+    void resetNodes() {
+        nodes = 0;
+    }
+
+private:
+    unsigned long long nodes;  // Every makeMove, interior and leaf
+};
+
+// Deliberately simple reference: a flat array and a run-length win scan
+// that shares no code with Board
+class NaivePerft {
+public:
+    NaivePerft(int size, int winCondition) : size(size), winCondition(winCondition), cells(size * size, EMPTY) {}
+
+    void set(int index, CellState state) {
+        cells[index] = state;
+    }
+
+    unsigned long long count(CellState toMove, int depth) {
+        if (depth == 0) return 1;
+        if (hasWinner()) return 0;
+
+        CellState next = (toMove == PLAYER_X) ? PLAYER_O : PLAYER_X;
+        unsigned long long leaves = 0;
+        for (int i = 0; i < size * size; i++) {
+            if (cells[i] != EMPTY) continue;
+            cells[i] = toMove;
+            leaves += count(next, depth - 1);
+            cells[i] = EMPTY;
+        }
+        return leaves;
+    }
+
+private:
+    int size;
+    int winCondition;
+    std::vector<CellState> cells;
+
+    bool hasWinner() const {
+        const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        for (int row = 0; row < size; row++) {
+            for (int col = 0; col < size; col++) {
+                CellState state = cells[row * size + col];
+                if (state == EMPTY) continue;
+
+                for (const auto& dir : directions) {
+                    int run = 0;
+                    int r = row;
+                    int c = col;
+                    while (r >= 0 && r < size && c >= 0 && c < size && cells[r * size + c] == state) {
+                        run++;
+                        r += dir[0];
+                        c += dir[1];
+                    }
+                    if (run >= winCondition) return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+// Builds the board for a case; returns false if the position string is invalid
+bool setupPosition(const PerftCase& perftCase, Board& board, CellState& toMove) {
+    int size = perftCase.boardSize;
+    board.resize(size, perftCase.winCondition);
+    if (perftCase.position.empty()) {
+        toMove = PLAYER_X;
+        return true;
+    }
+    if ((int)perftCase.position.size() != size * size) return false;
+
+    int xCount = 0;
+    int oCount = 0;
+    for (int i = 0; i < size * size; i++) {
+        char c = perftCase.position[i];
+        if (c == 'X' || c == 'x') {
+            board.makeMove(i / size, i % size, PLAYER_X);
+            xCount++;
+        } else if (c == 'O' || c == 'o') {
+            board.makeMove(i / size, i % size, PLAYER_O);
+            oCount++;
+        } else if (c != '.' && c != '-') {
+            return false;
+        }
+    }
+
+    // X moves first, so equal counts mean X is to move
+    if (xCount != oCount && xCount != oCount + 1) return false;
+    toMove = (xCount == oCount) ? PLAYER_X : PLAYER_O;
+    return true;
+}
+
+// Returns true and sets reference if a known-good count exists for this
+// depth. Nobody can win before ply 2 * winCondition - 1, so from an empty
+// board every sequence up to that depth is a legal continuation and the
+// count is simply N * (N - 1) * ... (depth factors).
+bool getReferenceCount(const PerftCase& perftCase, int depth, unsigned long long& reference) {
+    if (!perftCase.position.empty()) return false;
+
+    if (perftCase.boardSize == 3 && perftCase.winCondition == 3 && depth <= 9) {
+        reference = REFERENCE_3X3[depth - 1];
+        return true;
+    }
+
+    int cells = perftCase.boardSize * perftCase.boardSize;
+    if (depth <= 2 * perftCase.winCondition - 1 && depth <= cells) {
+        reference = 1;
+        for (int i = 0; i < depth; i++) {
+            reference *= (unsigned long long)(cells - i);
+        }
+        return true;
+    }
+    return false;
+}
+
+// Runs one case depth by depth; returns the number of mismatches
+int runCase(const PerftCase& perftCase, bool verify) {
+    Board board;
+    CellState toMove = PLAYER_X;
+    if (!setupPosition(perftCase, board, toMove)) {
+        std::cerr << "Invalid position \"" << perftCase.position << "\" for a "
+                  << perftCase.boardSize << "x" << perftCase.boardSize << " board\n";
+        return 1;
+    }
+
+    std::cout << "\n" << perftCase.boardSize << "x" << perftCase.boardSize << ", "
+              << perftCase.winCondition << " in a row, "
+              << (perftCase.position.empty() ? std::string("empty board") : perftCase.position)
+              << ", " << (toMove == PLAYER_X ? "X" : "O") << " to move\n";
+    std::cout << std::setw(6) << "depth" << std::setw(16) << "leaves" << std::setw(16) << "nodes"
+              << std::setw(12) << "ms" << std::setw(16) << "nodes/sec" << "  check\n";
+
+    int failures = 0;
+    Perft perft;
+
+    for (int depth = 1; depth <= perftCase.depth; depth++) {
+        perft.resetNodes();
+        auto start = std::chrono::steady_clock::now();
+        unsigned long long leaves = perft.count(board, toMove, depth);
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        double nodesPerSec = (elapsedMs > 0.0) ? perft.getNodes() / (elapsedMs / 1000.0) : 0.0;
+
+        std::string check = "-";
+        unsigned long long reference = 0;
+        bool hasReference = getReferenceCount(perftCase, depth, reference);
+        if (!hasReference && verify) {
+            NaivePerft naive(perftCase.boardSize, perftCase.winCondition);
+            for (int row = 0; row < perftCase.boardSize; row++) {
+                for (int col = 0; col < perftCase.boardSize; col++) {
+                    naive.set(row * perftCase.boardSize + col, board.getCell(row, col));
+                }
+            }
+            reference = naive.count(toMove, depth);
+            hasReference = true;
+        }
+        if (hasReference) {
+            check = (leaves == reference) ? "ok" : "MISMATCH (expected " + std::to_string(reference) + ")";
+            if (leaves != reference) failures++;
+        }
+
+        std::cout << std::setw(6) << depth << std::setw(16) << leaves << std::setw(16) << perft.getNodes()
+                  << std::setw(12) << std::fixed << std::setprecision(1) << elapsedMs
+                  << std::setw(16) << std::setprecision(0) << nodesPerSec << "  " << check << "\n";
+    }
+
+    return failures;
+}
+
+void printUsage() {
+    std::cout << "Usage: perft [--size N] [--win W] [--depth D] [--position CELLS] [--no-verify]\n";
+    std::cout << "  Without --size/--position the built-in suite is run.\n";
+    std::cout << "  CELLS lists the board row by row using X, O and '.', e.g. \"X...O....\".\n";
+}
+
+int main(int argc, char* argv[]) {
+    PerftOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--no-verify") {
+            options.verify = false;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--size") {
+            options.single.boardSize = std::atoi(value.c_str());
+            options.useSuite = false;
+        } else if (arg == "--win") {
+            options.single.winCondition = std::atoi(value.c_str());
+        } else if (arg == "--depth") {
+            options.single.depth = std::atoi(value.c_str());
+        } else if (arg == "--position") {
+            options.single.position = value;
+            options.useSuite = false;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::vector<PerftCase> cases;
+    if (options.useSuite) {
+        cases.assign(DEFAULT_SUITE, DEFAULT_SUITE + sizeof(DEFAULT_SUITE) / sizeof(DEFAULT_SUITE[0]));
+    } else {
+        PerftCase perftCase = options.single;
+        if (perftCase.boardSize < 3 || perftCase.boardSize > 6) {
+            std::cerr << "Board size must be between 3 and 6\n";
+            return 1;
+        }
+        if (perftCase.winCondition <= 0) {
+            perftCase.winCondition = getDefaultWinCondition(perftCase.boardSize);
+        }
+        if (perftCase.depth <= 0) {
+            perftCase.depth = (perftCase.boardSize == 3) ? 9 : 4;
+        }
+        cases.push_back(perftCase);
+    }
+
+    int failures = 0;
+    for (const auto& perftCase : cases) {
+        failures += runCase(perftCase, options.verify);
+    }
+
+    std::cout << "\n" << (failures == 0 ? "All counts match" : std::to_string(failures) + " count(s) did not match") << "\n";
+    return failures == 0 ? 0 : 1;
+}
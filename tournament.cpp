@@ -0,0 +1,270 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Board.h"
+#include "AI.h"
+#include "ScoreTracker.h"
+
+// Headless AI-vs-AI match runner. Plays games in parallel on all cores
+// using Board and AI directly (no SDL, no Game) and reports the result of
+// engine A against engine B as win/draw rates and an Elo difference.
+// With --history every worker also records its games into one shared
+// ScoreTracker in concurrent mode.
+const int TOURNAMENT_HISTORY_MODE = 4;  // History mode after the front end's GameMode values
+
+struct EngineConfig {
+    AILevel level;
+    int timeLimitMs;
+    
+    EngineConfig() : level(HARD), timeLimitMs(0) {}
+};
+
+struct TournamentOptions {
+    int boardSize;
+    int winCondition;
+    int games;
+    int threads;
+    int randomPlies;
+    unsigned int seed;
+    std::string historyFile;
+    EngineConfig engineA;
+    EngineConfig engineB;
+    
+    TournamentOptions() : boardSize(3), winCondition(0), games(1000), threads(0), randomPlies(2), seed(1) {}
+};
+
+// Results from engine A's point of view
+struct MatchResults {
+    int winsA;
+    int winsB;
+    int draws;
+    int xWins;
+    int oWins;
+    
+    MatchResults() : winsA(0), winsB(0), draws(0), xWins(0), oWins(0) {}
+    
+    void add(const MatchResults& other) {
+        winsA += other.winsA;
+        winsB += other.winsB;
+        draws += other.draws;
+        xWins += other.xWins;
+        oWins += other.oWins;
+    }
+    
+    int total() const {
+        return winsA + winsB + draws;
+    }
+};
+
+bool parseLevel(const std::string& name, AILevel& level) {
+    if (name == "easy") level = EASY;
+    else if (name == "medium") level = MEDIUM;
+    else if (name == "hard") level = HARD;
+    else if (name == "neural") level = NEURAL;
+    else return false;
+    return true;
+}
+
+const char* getLevelName(AILevel level) {
+    switch (level) {
+        case EASY: return "easy";
+        case MEDIUM: return "medium";
+        case HARD: return "hard";
+        case NEURAL: return "neural";
+    }
+    return "unknown";
+}
+
+void configureEngine(AI& ai, const EngineConfig& config, unsigned int seed) {
+    ai.setLevel(config.level);
+    ai.setTimeLimit(config.timeLimitMs);
+    ai.setSeed(seed);
+    ai.setPersistentCache(false); // Workers must not write the shared cache files
+}
+
+// Even games give A the X pieces (X always moves first), odd games give them to B
+// (history keys are the board size and engine A's level)
+void playGames(const TournamentOptions& options, std::atomic<int>& nextGame, MatchResults& results,
+               ScoreTracker* history, MoveLatencyTable* latency) {
+    AI engineA;
+    AI engineB;
+    engineA.setLatencyTable(&latency[0]);
+    engineB.setLatencyTable(&latency[1]);
+    
+    while (true) {
+        int game = nextGame.fetch_add(1);
+        if (game >= options.games) break;
+        
+        std::mt19937 gen(options.seed * 7919u + (unsigned int)game);
+        configureEngine(engineA, options.engineA, gen());
+        configureEngine(engineB, options.engineB, gen());
+        
+        bool aIsX = (game % 2 == 0);
+        Board board(options.boardSize, options.winCondition);
+        CellState toMove = PLAYER_X;
+        
+        for (int ply = 0; !board.checkWin().hasWinner && !board.isFull(); ply++) {
+            std::pair<int, int> move;
+            
+            if (ply < options.randomPlies) {
+                // Random openings so deterministic engines play different games
+                auto emptyCells = board.getEmptyCells();
+                std::uniform_int_distribution<> dis(0, (int)emptyCells.size() - 1);
+                move = emptyCells[dis(gen)];
+            } else {
+                bool aToMove = (toMove == PLAYER_X) == aIsX;
+                move = aToMove ? engineA.getMove(board, toMove) : engineB.getMove(board, toMove);
+            }
+            
+            if (!board.makeMove(move.first, move.second, toMove)) break;
+            toMove = (toMove == PLAYER_X) ? PLAYER_O : PLAYER_X;
+        }
+        
+        WinInfo winInfo = board.checkWin();
+        if (history) {
+            history->record(TOURNAMENT_HISTORY_MODE, options.boardSize, options.engineA.level,
+                            winInfo.hasWinner ? winInfo.winner : EMPTY);
+        }
+        if (!winInfo.hasWinner) {
+            results.draws++;
+        } else {
+            bool aWon = (winInfo.winner == PLAYER_X) == aIsX;
+            if (aWon) results.winsA++; else results.winsB++;
+            if (winInfo.winner == PLAYER_X) results.xWins++; else results.oWins++;
+        }
+    }
+}
+
+double eloFromScore(double score) {
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+std::string formatElo(double score) {
+    if (score <= 0.0) return "-inf";
+    if (score >= 1.0) return "+inf";
+    
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::showpos << eloFromScore(score);
+    return ss.str();
+}
+
+void printReport(const TournamentOptions& options, const MatchResults& results, const MoveLatencyTable* latency,
+                 double seconds) {
+    int n = results.total();
+    if (n == 0) return;
+    
+    // Per-game score mean and variance (win 1, draw 0.5, loss 0) give a
+    // 95% confidence interval on the score, mapped through the Elo curve
+    double score = (results.winsA + 0.5 * results.draws) / n;
+    double meanSquare = (results.winsA + 0.25 * results.draws) / n;
+    double variance = std::max(meanSquare - score * score, 0.0);
+    double margin = 1.96 * std::sqrt(variance / n);
+    
+    std::cout << "\n=== " << options.boardSize << "x" << options.boardSize << " (" << options.winCondition
+              << " in a row): A=" << getLevelName(options.engineA.level);
+    if (options.engineA.timeLimitMs > 0) std::cout << "/" << options.engineA.timeLimitMs << "ms";
+    std::cout << " vs B=" << getLevelName(options.engineB.level);
+    if (options.engineB.timeLimitMs > 0) std::cout << "/" << options.engineB.timeLimitMs << "ms";
+    std::cout << " ===\n";
+    
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Games:      " << n << " (" << options.threads << " threads)\n";
+    std::cout << "A wins:     " << results.winsA << " (" << 100.0 * results.winsA / n << "%)\n";
+    std::cout << "B wins:     " << results.winsB << " (" << 100.0 * results.winsB / n << "%)\n";
+    std::cout << "Draws:      " << results.draws << " (" << 100.0 * results.draws / n << "%)\n";
+    std::cout << "X/O wins:   " << results.xWins << " / " << results.oWins << "\n";
+    std::cout << "A score:    " << 100.0 * score << "%\n";
+    std::cout << "Elo (A-B):  " << formatElo(score) << "  [95% CI " << formatElo(score - margin) << ", "
+              << formatElo(score + margin) << "]\n";
+    std::cout << "A move time: " << latency[0].getSummary(options.engineA.level, options.boardSize) << "\n";
+    std::cout << "B move time: " << latency[1].getSummary(options.engineB.level, options.boardSize) << "\n";
+    std::cout << std::setprecision(2);
+    std::cout << "Time:       " << seconds << "s (" << n / seconds << " games/sec)\n";
+}
+
+void printUsage() {
+    std::cout << "Usage: tournament [--size N] [--win W] [--games G] [--threads T] [--random-plies P] [--seed S]\n";
+    std::cout << "                  [--a LEVEL] [--b LEVEL] [--time-a MS] [--time-b MS] [--history FILE]\n";
+    std::cout << "  LEVEL is easy, medium, hard or neural; --time-* sets a per-move budget for hard\n";
+    std::cout << "  --history adds the results to a history file (e.g. history.bin)\n";
+}
+
+int main(int argc, char* argv[]) {
+    TournamentOptions options;
+    options.engineB.level = MEDIUM;
+    
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        
+        std::string value = argv[++i];
+        if (arg == "--size") options.boardSize = std::atoi(value.c_str());
+        else if (arg == "--win") options.winCondition = std::atoi(value.c_str());
+        else if (arg == "--games") options.games = std::atoi(value.c_str());
+        else if (arg == "--threads") options.threads = std::atoi(value.c_str());
+        else if (arg == "--random-plies") options.randomPlies = std::atoi(value.c_str());
+        else if (arg == "--seed") options.seed = (unsigned int)std::atoi(value.c_str());
+        else if (arg == "--time-a") options.engineA.timeLimitMs = std::atoi(value.c_str());
+        else if (arg == "--time-b") options.engineB.timeLimitMs = std::atoi(value.c_str());
+        else if (arg == "--history") options.historyFile = value;
+        else if (arg == "--a" && parseLevel(value, options.engineA.level)) continue;
+        else if (arg == "--b" && parseLevel(value, options.engineB.level)) continue;
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    
+    if (options.boardSize < 3 || options.boardSize > 6) {
+        std::cerr << "Board size must be between 3 and 6\n";
+        return 1;
+    }
+    if (options.winCondition <= 0) options.winCondition = getDefaultWinCondition(options.boardSize);
+    if (options.threads <= 0) options.threads = std::max(1u, std::thread::hardware_concurrency());
+    
+    ScoreTracker history;
+    if (!options.historyFile.empty()) {
+        if (!history.openHistory(options.historyFile)) {
+            std::cerr << "Cannot open history " << options.historyFile << "\n";
+            return 1;
+        }
+        history.enableConcurrent();
+    }
+    ScoreTracker* sharedHistory = options.historyFile.empty() ? nullptr : &history;
+    
+    MoveLatencyTable latency[2];  // Engine A, engine B (random opening plies are not timed)
+    std::atomic<int> nextGame(0);
+    std::vector<MatchResults> workerResults(options.threads);
+    std::vector<std::thread> workers;
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.threads; i++) {
+        workers.emplace_back(playGames, std::cref(options), std::ref(nextGame), std::ref(workerResults[i]),
+                             sharedHistory, latency);
+    }
+    
+    MatchResults results;
+    for (int i = 0; i < options.threads; i++) {
+        workers[i].join();
+        results.add(workerResults[i]);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    printReport(options, results, latency, seconds);
+    if (sharedHistory) {
+        history.disableConcurrent();
+        std::cout << "History:    " << history.getStatsString() << "\n";
+    }
+    return 0;
+}
\ No newline at end of file